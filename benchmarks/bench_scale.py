@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""
+Scale Benchmarks
+
+Times startup, listing, status and prompt-building paths on large workspaces:
+- CLI round trips: `tracer status`, `tracer list`, `rpi status`
+- In-process: Tracer.__init__, spec context, RPI prompt builders, usage loading
+- Compared against benchmarks/baselines/scale-<preset>.json
+"""
+from __future__ import annotations
+
+import os
+import sys
+import json
+import subprocess
+from pathlib import Path
+
+from harness import BENCH_DIR, measure, load_baseline, save_results, report, DEFAULT_TOLERANCE
+from generate_workspace import PRESETS, generate_workspace, size_from_args, add_arguments
+
+REPO_ROOT = BENCH_DIR.parent
+CONTROLLER_DIR = REPO_ROOT / "controller"
+RUN_PY = CONTROLLER_DIR / "run.py"
+WORKSPACES_DIR = BENCH_DIR / ".workspaces"
+
+CLI_BENCHMARKS = {
+    "cli:tracer status": ["tracer", "status"],
+    "cli:tracer list": ["tracer", "list"],
+    "cli:rpi status": ["rpi", "status"],
+}
+
+
+def _child_env() -> dict:
+    env = dict(os.environ)
+    for key in ("TRACER_WORKSPACE", "ORCHESTRATOR_WORKSPACE", "ORCHESTRATOR_MEMPROFILE"):
+        env.pop(key, None)
+    return env
+
+
+# ============================================================================
+# IN-PROCESS BENCHMARKS (run inside the generated workspace)
+# ============================================================================
+
+def run_inprocess(warmup: int, repeat: int, only: str) -> dict:
+    """Executed in a child whose cwd is the workspace, so controller paths resolve there."""
+    sys.path.insert(0, str(CONTROLLER_DIR))
+    import utils
+    import tracer as tracer_mod
+    import rpi_loop
+    import scheduler
+
+    story = utils.get_current_story(rpi_loop.PROJECT_STATUS_FILE, rpi_loop.PROJECT_PROMPT_FILE)
+    state = utils.load_state(rpi_loop.STATE_FILE)
+    tracer = tracer_mod.Tracer()
+    spec = next(iter(tracer.specs.values()), None)
+
+    cases = {
+        "tracer:init": lambda: tracer_mod.Tracer(),
+        "rpi:current_story": lambda: utils.get_current_story(rpi_loop.PROJECT_STATUS_FILE,
+                                                             rpi_loop.PROJECT_PROMPT_FILE),
+        "rpi:researcher_prompt": lambda: rpi_loop.get_researcher_prompt(story),
+        "rpi:planner_prompt": lambda: rpi_loop.get_planner_prompt(story),
+        "rpi:implementer_prompt": lambda: rpi_loop.get_implementer_prompt(story, state.version + 1),
+        "rpi:grader_prompt": lambda: rpi_loop.get_grader_prompt(story, state.version),
+        "usage:load_records": lambda: utils.load_usage_records(),
+        "scheduler:eta_model": lambda: scheduler.EtaModel(),
+    }
+    if spec:
+        cases["tracer:spec_context"] = lambda: tracer._spec_context(spec, ("title", "requirements"), 2000)
+
+    results = {}
+    for name, fn in cases.items():
+        if only and only not in name:
+            continue
+        results[name] = measure(fn, warmup=warmup, repeat=repeat)
+    return results
+
+
+# ============================================================================
+# DRIVER
+# ============================================================================
+
+def run_cli_benchmarks(workspace: Path, warmup: int, repeat: int, only: str) -> dict:
+    env = _child_env()
+    results = {}
+    for name, argv in CLI_BENCHMARKS.items():
+        if only and only not in name:
+            continue
+        cmd = [sys.executable, str(RUN_PY), *argv]
+
+        def call(cmd=cmd):
+            subprocess.run(cmd, cwd=str(workspace), env=env, check=True,
+                           stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
+        results[name] = measure(call, warmup=warmup, repeat=repeat)
+    return results
+
+
+def run_child(workspace: Path, warmup: int, repeat: int, only: str) -> dict:
+    out_file = workspace / "state" / "bench_inprocess.json"
+    subprocess.run(
+        [sys.executable, str(Path(__file__).resolve()), "--child", str(out_file),
+         "--warmup", str(warmup), "--repeat", str(repeat), "--only", only],
+        cwd=str(workspace), env=_child_env(), check=True, stdout=subprocess.DEVNULL,
+    )
+    results = json.loads(out_file.read_text())
+    out_file.unlink()
+    return results
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Scale benchmarks on synthetic workspaces")
+    add_arguments(parser)
+    parser.add_argument("--workspace", help="Workspace directory (default: benchmarks/.workspaces/<preset>)")
+    parser.add_argument("--warmup", type=int, default=1)
+    parser.add_argument("--repeat", type=int, default=5)
+    parser.add_argument("--only", default="", help="Run benchmarks whose name contains this text")
+    parser.add_argument("--tolerance", type=float, default=DEFAULT_TOLERANCE,
+                        help="Allowed median slowdown before flagging a regression")
+    parser.add_argument("--update-baseline", action="store_true", help="Store results as the new baseline")
+    parser.add_argument("--child", help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    if args.child:
+        results = run_inprocess(args.warmup, args.repeat, args.only)
+        Path(args.child).write_text(json.dumps(results))
+        return
+
+    size = size_from_args(args)
+    custom = any(getattr(args, k) is not None for k in ("specs", "tickets", "usage", "versions"))
+    name = f"scale-{'custom' if custom else args.preset}"
+    workspace = Path(args.workspace) if args.workspace else WORKSPACES_DIR / (
+        "custom" if custom else args.preset)
+
+    print(f"Preparing {workspace} ({size.specs} specs, {size.tickets} tickets, "
+          f"{size.usage} usage records, {size.versions} versions)...")
+    generate_workspace(workspace, size)
+
+    results = run_cli_benchmarks(workspace, args.warmup, args.repeat, args.only)
+    results.update(run_child(workspace, args.warmup, args.repeat, args.only))
+
+    meta = {"size": size.__dict__, "preset": None if custom else args.preset}
+    baseline = load_baseline(name)
+    saved = save_results(name, results, meta, baseline=args.update_baseline)
+    regressions = report(f"Scale Benchmarks ({name})", results, baseline, args.tolerance)
+    print(f"Results: {saved}")
+    sys.exit(1 if regressions and not args.update_baseline else 0)
+
+
+if __name__ == "__main__":
+    main()
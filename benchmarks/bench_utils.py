@@ -0,0 +1,138 @@
+#!/usr/bin/env python3
+"""
+Utils Microbenchmarks
+
+Per-call timings for the helpers every phase goes through:
+- compact_text, _extract_heading_section, load_project_context, extract_score
+- _default_cache_key, _load_cache (hit/miss), save_state
+- Realistic and adversarial inputs (multi-MB markdown, thousands of headings,
+  regex worst cases), compared against benchmarks/baselines/micro-utils.json
+"""
+from __future__ import annotations
+
+import sys
+import random
+import tempfile
+from pathlib import Path
+
+from harness import BENCH_DIR, calibrate, measure, load_baseline, save_results, report, DEFAULT_TOLERANCE
+
+sys.path.insert(0, str(BENCH_DIR.parent / "controller"))
+import utils  # noqa: E402
+
+BASELINE_NAME = "micro-utils"
+WORDS = ("parser", "cache", "session", "ledger", "report", "export", "schema", "queue",
+         "index", "billing", "auth", "upload", "search", "metrics", "webhook", "profile")
+
+
+# ============================================================================
+# INPUTS
+# ============================================================================
+
+def _phrase(rng: random.Random, n: int) -> str:
+    return " ".join(rng.choice(WORDS) for _ in range(n))
+
+
+def project_markdown(stories: int, bullets: int, seed: int = 0) -> str:
+    """PROJECT_PROMPT.md-shaped text: one ### section per story."""
+    rng = random.Random(seed)
+    lines = ["# Project Prompt", ""]
+    for s in range(1, stories + 1):
+        lines += [f"### US-{s}: {_phrase(rng, 3).title()}", ""]
+        lines += [f"- {_phrase(rng, 10)}" for _ in range(bullets)]
+        lines.append("")
+    return "\n".join(lines)
+
+
+def build_inputs() -> dict[str, str]:
+    realistic = project_markdown(stories=40, bullets=12)
+    multi_mb = project_markdown(stories=400, bullets=400)
+    many_headings = "\n".join(f"## Heading {i}\ntext {i}" for i in range(20000))
+    return {
+        "realistic": realistic,
+        "multi_mb": multi_mb,
+        "many_headings": many_headings,
+        # Heading lines made of whitespace exercise the header regex's backtracking
+        "whitespace_headings": "\n".join("#" * (i % 6 + 1) + " " * 2000 for i in range(2000)),
+        "grading": realistic + "\n\n**Score:** 87\n",
+        # Thousands of near-matches and no score at all: every pattern scans the whole text
+        "score_near_miss": "Score: /100 score:  x " * 50000,
+    }
+
+
+# ============================================================================
+# CASES
+# ============================================================================
+
+def build_cases(inputs: dict[str, str], workdir: Path) -> dict:
+    utils.CACHE_DIR = workdir / "cache"
+    big_output = inputs["multi_mb"][:1_000_000]
+    utils._save_cache("bench:hit", big_output)
+    utils._save_cache("bench:small", "ok")
+
+    prompt_file = workdir / "PROJECT_PROMPT.md"
+    prompt_file.write_text(inputs["multi_mb"])
+    state_file = workdir / "rpi_state.json"
+    state = utils.LoopState(version=300, history=[{"version": v, "score": v % 100} for v in range(300)])
+
+    realistic, multi_mb = inputs["realistic"], inputs["multi_mb"]
+    many, ws = inputs["many_headings"], inputs["whitespace_headings"]
+    last_story = "US-400"
+
+    return {
+        "compact_text:realistic": lambda: utils.compact_text(realistic, 5000),
+        "compact_text:multi_mb": lambda: utils.compact_text(multi_mb, 5000),
+        "heading_section:realistic": lambda: utils._extract_heading_section(realistic, "US-20"),
+        "heading_section:multi_mb_last": lambda: utils._extract_heading_section(multi_mb, last_story),
+        "heading_section:many_headings_miss": lambda: utils._extract_heading_section(many, "US-1"),
+        "heading_section:whitespace_headings": lambda: utils._extract_heading_section(ws, "US-1"),
+        "project_context:multi_mb": lambda: utils.load_project_context(prompt_file, 5000, last_story),
+        "project_context:multi_mb_miss": lambda: utils.load_project_context(prompt_file, 5000, "US-9999"),
+        "extract_score:grading": lambda: utils.extract_score(inputs["grading"]),
+        "extract_score:near_miss": lambda: utils.extract_score(inputs["score_near_miss"]),
+        "cache_key:realistic": lambda: utils._default_cache_key(realistic, "gpt-5.2-codex", "rpi:research"),
+        "cache_key:multi_mb": lambda: utils._default_cache_key(multi_mb, "gpt-5.2-codex", "rpi:research"),
+        "load_cache:hit_1mb": lambda: utils._load_cache("bench:hit"),
+        "load_cache:hit_small": lambda: utils._load_cache("bench:small"),
+        "load_cache:miss": lambda: utils._load_cache("bench:missing"),
+        "save_state:300_versions": lambda: utils.save_state(state, state_file),
+    }
+
+
+# ============================================================================
+# CLI
+# ============================================================================
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Microbenchmarks for utils hot paths")
+    parser.add_argument("--warmup", type=int, default=2)
+    parser.add_argument("--repeat", type=int, default=7)
+    parser.add_argument("--min-sample", type=float, default=0.05,
+                        help="Minimum seconds per sample (calls per sample are calibrated)")
+    parser.add_argument("--only", default="", help="Run benchmarks whose name contains this text")
+    parser.add_argument("--tolerance", type=float, default=DEFAULT_TOLERANCE)
+    parser.add_argument("--update-baseline", action="store_true", help="Store results as the new baseline")
+    args = parser.parse_args()
+
+    inputs = build_inputs()
+    results = {}
+    with tempfile.TemporaryDirectory(prefix="bench-utils-") as tmp:
+        for name, fn in build_cases(inputs, Path(tmp)).items():
+            if args.only and args.only not in name:
+                continue
+            number = calibrate(fn, args.min_sample)
+            results[name] = dict(measure(fn, warmup=args.warmup, repeat=args.repeat, number=number),
+                                 number=number)
+
+    meta = {"inputs": {k: len(v) for k, v in inputs.items()}}
+    baseline = load_baseline(BASELINE_NAME)
+    saved = save_results(BASELINE_NAME, results, meta, baseline=args.update_baseline)
+    regressions = report("Utils Microbenchmarks (per call)", results, baseline, args.tolerance)
+    print(f"Results: {saved}")
+    sys.exit(1 if regressions and not args.update_baseline else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,255 @@
+#!/usr/bin/env python3
+"""
+Synthetic Workspace Generator
+
+Builds orchestrator workspaces of configurable size for scale benchmarks:
+- specs/ and tickets/ in the Tracer on-disk format
+- state/usage.jsonl with realistic label/model/token mixes
+- submission/V*/ and grading/V*.md for hundreds of RPI versions
+- PROJECT_PROMPT.md / PROJECT_STATUS.md / rubric.md / .claude/ commands
+"""
+from __future__ import annotations
+
+import json
+import random
+import shutil
+import hashlib
+from pathlib import Path
+from datetime import datetime, timedelta
+from dataclasses import dataclass, asdict
+
+MANIFEST = ".bench_workspace.json"
+
+PRESETS = {
+    "small": {"specs": 200, "tickets": 1000, "usage": 20000, "versions": 20},
+    "medium": {"specs": 2000, "tickets": 10000, "usage": 200000, "versions": 100},
+    "large": {"specs": 10000, "tickets": 50000, "usage": 1000000, "versions": 300},
+}
+
+USAGE_LABELS = (
+    ("tracer:execute:implement", 300.0, 9000, 3000),
+    ("tracer:execute:review", 60.0, 4000, 600),
+    ("tracer:execute:verify", 120.0, 5000, 900),
+    ("tracer:execute:correct", 240.0, 7000, 2500),
+    ("tracer:ticket:tasks", 20.0, 1500, 300),
+    ("tracer:spec:draft", 40.0, 2000, 800),
+    ("rpi:research", 300.0, 8000, 2500),
+    ("rpi:plan", 240.0, 7000, 2000),
+    ("rpi:implement", 450.0, 12000, 4000),
+    ("rpi:grade", 240.0, 6000, 1500),
+    ("orch:coder", 180.0, 6000, 2000),
+)
+MODELS = ("gpt-5.2-codex", "gpt-5.1-codex-mini", None)
+WORDS = ("parser", "cache", "session", "ledger", "report", "export", "schema", "queue",
+         "index", "billing", "auth", "upload", "search", "metrics", "webhook", "profile")
+
+
+@dataclass
+class WorkspaceSize:
+    specs: int
+    tickets: int
+    usage: int
+    versions: int
+    seed: int = 0
+
+
+# ============================================================================
+# CONTENT
+# ============================================================================
+
+def _phrase(rng: random.Random, n: int = 4) -> str:
+    return " ".join(rng.choice(WORDS) for _ in range(n))
+
+
+def _spec_id(i: int) -> str:
+    return f"SPEC-{hashlib.md5(f'spec-{i}'.encode()).hexdigest()[:8].upper()}"
+
+
+def _ticket_id(i: int) -> str:
+    return f"TKT-{hashlib.md5(f'ticket-{i}'.encode()).hexdigest()[:8].upper()}"
+
+
+def _write_project_files(root: Path, size: WorkspaceSize, rng: random.Random):
+    stories = max(20, size.versions)
+    lines = ["# Project Prompt", "", "Synthetic project for scale benchmarks.", ""]
+    for s in range(1, stories + 1):
+        lines += [f"### US-{s}: {_phrase(rng, 3).title()}", ""]
+        lines += [f"- {_phrase(rng, 8)}" for _ in range(6)]
+        lines.append("")
+    (root / "PROJECT_PROMPT.md").write_text("\n".join(lines))
+    (root / "PROJECT_STATUS.md").write_text(
+        f"# Project Status\n\n| Field | Value |\n|---|---|\n| **Current Story** | US-{stories} |\n")
+    rubric = ["# Rubric", ""] + [f"## Criterion {i}\n\n{_phrase(rng, 12)}\n" for i in range(1, 11)]
+    (root / "rubric.md").write_text("\n".join(rubric))
+
+    commands = root / ".claude" / "commands"
+    commands.mkdir(parents=True, exist_ok=True)
+    for name in ("research", "plan", "implement", "grade"):
+        body = "\n".join(f"- {_phrase(rng, 10)}" for _ in range(30))
+        (commands / f"{name}.md").write_text(f"---\ndescription: {name}\n---\n# {name.title()}\n\n{body}\n")
+
+
+def _write_specs(root: Path, size: WorkspaceSize, rng: random.Random):
+    specs_dir = root / "specs"
+    specs_dir.mkdir(parents=True, exist_ok=True)
+    for i in range(size.specs):
+        title = _phrase(rng, 4).title()
+        data = {
+            "id": _spec_id(i), "title": title, "description": _phrase(rng, 30),
+            "requirements": [_phrase(rng, 10) for _ in range(rng.randint(3, 8))],
+            "acceptance_criteria": [_phrase(rng, 8) for _ in range(rng.randint(2, 6))],
+            "constraints": [_phrase(rng, 6) for _ in range(rng.randint(0, 3))],
+            "out_of_scope": [_phrase(rng, 5) for _ in range(rng.randint(0, 3))],
+            "clarifications": [], "version": 1, "status": "approved",
+        }
+        (specs_dir / f"{data['id']}.json").write_text(json.dumps(data, indent=2))
+        md = [f"# Spec: {title}", "", f"**ID:** {data['id']}", "", "## Requirements", ""]
+        md += [f"{n}. {r}" for n, r in enumerate(data["requirements"], 1)]
+        (specs_dir / f"{data['id']}.md").write_text("\n".join(md) + "\n")
+
+
+def _write_tickets(root: Path, size: WorkspaceSize, rng: random.Random):
+    tickets_dir = root / "tickets"
+    tickets_dir.mkdir(parents=True, exist_ok=True)
+    statuses = ("completed", "completed", "completed", "in_progress", "refined", "blocked")
+    for i in range(size.tickets):
+        status = rng.choice(statuses)
+        tasks = [{"name": _phrase(rng, 3), "type": rng.choice(("research", "code", "test")),
+                  "done": status == "completed" or rng.random() < 0.5}
+                 for _ in range(rng.randint(2, 6))]
+        iterations = [{"iteration": n + 1, "task": tasks[0]["name"], "all_met": rng.random() < 0.7,
+                       "reviewed": True} for n in range(rng.randint(0, 4))]
+        data = {
+            "id": _ticket_id(i), "spec_id": _spec_id(i % max(1, size.specs)),
+            "title": _phrase(rng, 4).title(), "description": _phrase(rng, 20),
+            "status": status, "tasks": tasks,
+            "progress": int(100 * sum(t["done"] for t in tasks) / len(tasks)),
+            "deviations": [], "iterations": iterations,
+            "deadline": None, "eta_sec": 0.0, "estimated_cost": 0.0, "checkpoint": {},
+        }
+        (tickets_dir / f"{data['id']}.json").write_text(json.dumps(data, indent=2))
+
+
+def _write_usage(root: Path, size: WorkspaceSize, rng: random.Random):
+    state = root / "state"
+    state.mkdir(parents=True, exist_ok=True)
+    start = datetime(2026, 1, 1)
+    step = timedelta(seconds=30)
+    with (state / "usage.jsonl").open("w", encoding="utf-8") as f:
+        batch = []
+        for i in range(size.usage):
+            label, latency, in_tok, out_tok = rng.choice(USAGE_LABELS)
+            if rng.random() < 0.15:
+                label += ":cache"
+            tin = int(in_tok * rng.uniform(0.5, 1.5))
+            tout = int(out_tok * rng.uniform(0.5, 1.5))
+            batch.append(json.dumps({
+                "ts": (start + step * i).isoformat(), "label": label, "cli": "claude",
+                "model": rng.choice(MODELS), "in_tokens": tin, "out_tokens": tout,
+                "total_tokens": tin + tout, "elapsed_sec": round(latency * rng.uniform(0.5, 1.5), 3),
+            }))
+            if len(batch) >= 10000:
+                f.write("\n".join(batch) + "\n")
+                batch.clear()
+        if batch:
+            f.write("\n".join(batch) + "\n")
+
+
+def _write_rpi(root: Path, size: WorkspaceSize, rng: random.Random):
+    stories = max(20, size.versions)
+    for d in ("research", "plans", "submission", "grading"):
+        (root / d).mkdir(parents=True, exist_ok=True)
+    (root / "research" / f"US-{stories}_research.md").write_text(
+        "# Research\n\n" + "\n".join(f"- {_phrase(rng, 12)}" for _ in range(200)))
+    (root / "plans" / f"US-{stories}_plan.md").write_text(
+        "# Plan\n\n" + "\n".join(f"{n}. {_phrase(rng, 12)}" for n in range(1, 200)))
+
+    history = []
+    for v in range(1, size.versions + 1):
+        sub = root / "submission" / f"V{v}"
+        sub.mkdir(parents=True, exist_ok=True)
+        (sub / "SUBMISSION.md").write_text(f"# Submission V{v}\n\n{_phrase(rng, 60)}\n")
+        score = min(100, 40 + v // 3 + rng.randint(0, 10))
+        (root / "grading" / f"V{v}.md").write_text(f"# Grading V{v}\n\nSCORE: {score}/100\n")
+        history.append({"version": v, "score": score})
+
+    rpi_state = {
+        "mode": "rpi", "current_story": f"US-{stories}", "current_phase": "grade",
+        "iteration": size.versions, "version": size.versions,
+        "score": history[-1]["score"] if history else 0, "history": history,
+        "spec_id": None, "ticket_id": None, "deviations_detected": 0, "deviations_corrected": 0,
+        "started_at": "2026-01-01T00:00:00", "last_activity": "2026-01-01T00:00:00",
+    }
+    (root / "state" / "rpi_state.json").write_text(json.dumps(rpi_state, indent=2))
+    tracer_state = dict(rpi_state, mode="tracer", history=[], ticket_id=_ticket_id(0),
+                        spec_id=_spec_id(0))
+    (root / "state" / "tracer_state.json").write_text(json.dumps(tracer_state, indent=2))
+
+
+# ============================================================================
+# GENERATION
+# ============================================================================
+
+def generate_workspace(root: Path, size: WorkspaceSize, force: bool = False) -> Path:
+    """Create (or reuse, when the manifest matches) a workspace of the given size."""
+    root = Path(root)
+    manifest = root / MANIFEST
+    if not force and manifest.exists():
+        try:
+            if json.loads(manifest.read_text()) == asdict(size):
+                return root
+        except ValueError:
+            pass
+    if root.exists():
+        shutil.rmtree(root)
+    root.mkdir(parents=True)
+
+    rng = random.Random(size.seed)
+    _write_project_files(root, size, rng)
+    _write_specs(root, size, rng)
+    _write_tickets(root, size, rng)
+    _write_usage(root, size, rng)
+    _write_rpi(root, size, rng)
+    manifest.write_text(json.dumps(asdict(size)))
+    return root
+
+
+def size_from_args(args) -> WorkspaceSize:
+    preset = PRESETS[args.preset]
+    return WorkspaceSize(
+        specs=args.specs if args.specs is not None else preset["specs"],
+        tickets=args.tickets if args.tickets is not None else preset["tickets"],
+        usage=args.usage if args.usage is not None else preset["usage"],
+        versions=args.versions if args.versions is not None else preset["versions"],
+        seed=args.seed,
+    )
+
+
+def add_arguments(parser):
+    parser.add_argument("--preset", choices=sorted(PRESETS), default="small")
+    parser.add_argument("--specs", type=int)
+    parser.add_argument("--tickets", type=int)
+    parser.add_argument("--usage", type=int, help="Usage records in state/usage.jsonl")
+    parser.add_argument("--versions", type=int, help="RPI submission/grading versions")
+    parser.add_argument("--seed", type=int, default=0)
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Generate a synthetic orchestrator workspace")
+    parser.add_argument("output", help="Workspace directory (replaced if it exists)")
+    add_arguments(parser)
+    parser.add_argument("--force", action="store_true", help="Regenerate even if the manifest matches")
+    args = parser.parse_args()
+
+    size = size_from_args(args)
+    started = datetime.now()
+    root = generate_workspace(Path(args.output), size, force=args.force)
+    print(f"Workspace {root}: {size.specs} specs, {size.tickets} tickets, "
+          f"{size.usage} usage records, {size.versions} versions "
+          f"({(datetime.now() - started).total_seconds():.1f}s)")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+"""
+Benchmark Harness
+
+Shared timing and comparison helpers for the benchmark suites:
+- Warmup + repeated measurement with summary statistics
+- Baseline comparison (median ratio + Mann-Whitney U significance)
+- JSON results under benchmarks/results/, baselines under benchmarks/baselines/
+"""
+from __future__ import annotations
+
+import json
+import math
+import time
+import platform
+import statistics
+from pathlib import Path
+from datetime import datetime
+from typing import Callable, Optional
+
+BENCH_DIR = Path(__file__).resolve().parent
+RESULTS_DIR = BENCH_DIR / "results"
+BASELINES_DIR = BENCH_DIR / "baselines"
+
+DEFAULT_TOLERANCE = 0.20
+SIGNIFICANCE = 0.05
+
+
+class Colors:
+    RESET = "\033[0m"
+    RED = "\033[91m"
+    GREEN = "\033[92m"
+    YELLOW = "\033[93m"
+    CYAN = "\033[96m"
+    GRAY = "\033[90m"
+
+
+# ============================================================================
+# MEASUREMENT
+# ============================================================================
+
+def calibrate(fn: Callable[[], object], min_sample: float = 0.05) -> int:
+    """Calls per sample so that each sample lasts at least `min_sample` seconds."""
+    number = 1
+    while True:
+        start = time.perf_counter()
+        for _ in range(number):
+            fn()
+        if time.perf_counter() - start >= min_sample or number >= 1_000_000:
+            return number
+        number *= 10
+
+
+def measure(fn: Callable[[], object], warmup: int = 1, repeat: int = 5, number: int = 1) -> dict:
+    """Time fn: `warmup` discarded runs, then `repeat` samples of `number` calls each."""
+    for _ in range(warmup):
+        fn()
+    samples = []
+    for _ in range(repeat):
+        start = time.perf_counter()
+        for _ in range(number):
+            fn()
+        samples.append((time.perf_counter() - start) / number)
+    return summarize(samples)
+
+
+def summarize(samples: list[float]) -> dict:
+    ordered = sorted(samples)
+    return {
+        "n": len(samples),
+        "mean": statistics.fmean(samples),
+        "median": statistics.median(samples),
+        "stdev": statistics.stdev(samples) if len(samples) > 1 else 0.0,
+        "min": ordered[0],
+        "max": ordered[-1],
+        "p90": ordered[min(len(ordered) - 1, int(0.9 * len(ordered)))],
+        "samples": samples,
+    }
+
+
+# ============================================================================
+# COMPARISON
+# ============================================================================
+
+def mann_whitney_p(a: list[float], b: list[float]) -> float:
+    """Two-sided Mann-Whitney U p-value (normal approximation, tie-corrected ranks)."""
+    n1, n2 = len(a), len(b)
+    if n1 < 2 or n2 < 2:
+        return 1.0
+    combined = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+    ranks = [0.0] * len(combined)
+    i = 0
+    while i < len(combined):
+        j = i
+        while j + 1 < len(combined) and combined[j + 1][0] == combined[i][0]:
+            j += 1
+        for k in range(i, j + 1):
+            ranks[k] = (i + j) / 2 + 1
+        i = j + 1
+    r1 = sum(r for r, (_, group) in zip(ranks, combined) if group == 0)
+    u1 = r1 - n1 * (n1 + 1) / 2
+    mean_u = n1 * n2 / 2
+    sd_u = math.sqrt(n1 * n2 * (n1 + n2 + 1) / 12)
+    if sd_u == 0:
+        return 1.0
+    z = abs(u1 - mean_u) / sd_u
+    return math.erfc(z / math.sqrt(2))
+
+
+def compare(current: dict, baseline: Optional[dict], tolerance: float = DEFAULT_TOLERANCE) -> dict:
+    """Classify a result against its baseline: regression, improvement, same or new."""
+    if not baseline:
+        return {"verdict": "new", "ratio": None, "p": None}
+    ratio = current["median"] / baseline["median"] if baseline["median"] else float("inf")
+    p = mann_whitney_p(current.get("samples", []), baseline.get("samples", []))
+    significant = p < SIGNIFICANCE or min(current["n"], baseline["n"]) < 4
+    if ratio > 1 + tolerance and significant:
+        verdict = "regression"
+    elif ratio < 1 - tolerance and significant:
+        verdict = "improvement"
+    else:
+        verdict = "same"
+    return {"verdict": verdict, "ratio": ratio, "p": p}
+
+
+# ============================================================================
+# RESULTS
+# ============================================================================
+
+def environment() -> dict:
+    return {
+        "python": platform.python_version(),
+        "machine": platform.machine(),
+        "system": platform.system(),
+        "ts": datetime.now().isoformat(timespec="seconds"),
+    }
+
+
+def load_baseline(name: str) -> dict:
+    path = BASELINES_DIR / f"{name}.json"
+    if not path.exists():
+        return {}
+    return json.loads(path.read_text()).get("results", {})
+
+
+def save_results(name: str, results: dict, meta: Optional[dict] = None, baseline: bool = False) -> Path:
+    target_dir = BASELINES_DIR if baseline else RESULTS_DIR
+    target_dir.mkdir(parents=True, exist_ok=True)
+    path = target_dir / f"{name}.json"
+    payload = {"env": environment(), "meta": meta or {}, "results": results}
+    path.write_text(json.dumps(payload, indent=2))
+    return path
+
+
+def report(title: str, results: dict, baseline: dict, tolerance: float = DEFAULT_TOLERANCE) -> int:
+    """Print a comparison table; returns the number of regressions."""
+    print()
+    print(f"{Colors.CYAN}═══ {title} ═══{Colors.RESET}")
+    print(f"  {'benchmark':<40} {'median':>10} {'stdev':>10} {'baseline':>10} {'ratio':>7}  verdict")
+    regressions = 0
+    for name, result in results.items():
+        base = baseline.get(name)
+        cmp = compare(result, base, tolerance)
+        color = {"regression": Colors.RED, "improvement": Colors.GREEN}.get(cmp["verdict"], Colors.GRAY)
+        regressions += cmp["verdict"] == "regression"
+        base_txt = _fmt(base["median"]) if base else "—"
+        ratio_txt = f"{cmp['ratio']:.2f}x" if cmp["ratio"] is not None else "—"
+        print(f"  {name:<40} {_fmt(result['median']):>10} {_fmt(result['stdev']):>10} "
+              f"{base_txt:>10} {ratio_txt:>7}  {color}{cmp['verdict']}{Colors.RESET}")
+    print()
+    return regressions
+
+
+def _fmt(seconds: float) -> str:
+    if seconds >= 1:
+        return f"{seconds:.2f}s"
+    if seconds >= 1e-3:
+        return f"{seconds * 1e3:.1f}ms"
+    return f"{seconds * 1e6:.1f}µs"
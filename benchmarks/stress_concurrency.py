@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+"""
+Concurrency Stress Harness
+
+Launches N orchestrator processes against one workspace and hammers the
+shared state they write without coordination:
+- state/cache/ (run_cli through the stub CLI, plus direct _save_cache/_load_cache)
+- state/*.json (read-modify-write through load_state/save_state)
+- state/usage.jsonl (_log_usage appends)
+Reports throughput per operation and integrity violations: torn JSON,
+lost updates, missing/duplicate/corrupt usage records.
+"""
+from __future__ import annotations
+
+import os
+import sys
+import json
+import time
+import random
+import hashlib
+import tempfile
+import subprocess
+from pathlib import Path
+
+from harness import BENCH_DIR, Colors
+
+CONTROLLER_DIR = BENCH_DIR.parent / "controller"
+OPS = ("cache", "state", "usage", "run_cli")
+SHARED_STATE = "stress_state.json"
+
+
+def _payload(key: str, writer: int, seq: int, size: int) -> str:
+    body = hashlib.sha256(f"{key}:{writer}:{seq}".encode()).hexdigest() * (size // 64 + 1)
+    body = body[:size]
+    return json.dumps({"key": key, "writer": writer, "seq": seq,
+                       "sha": hashlib.sha256(body.encode()).hexdigest(), "body": body})
+
+
+def _payload_ok(text: str, key: str) -> bool:
+    try:
+        data = json.loads(text)
+        return data["key"] == key and hashlib.sha256(data["body"].encode()).hexdigest() == data["sha"]
+    except (ValueError, KeyError, TypeError):
+        return False
+
+
+# ============================================================================
+# WORKER (one process, cwd = shared workspace)
+# ============================================================================
+
+def run_worker(worker: int, args) -> dict:
+    sys.path.insert(0, str(CONTROLLER_DIR))
+    import utils
+
+    rng = random.Random(args.seed * 1000 + worker)
+    state_file = utils.STATE_DIR / SHARED_STATE
+    keys = [f"stress:key{k}" for k in range(args.keys)]
+    weights = [float(w) for w in args.mix.split(",")]
+
+    counts = {op: 0 for op in OPS}
+    seconds = {op: 0.0 for op in OPS}
+    violations: list[dict] = []
+    increments = 0
+    usage_seq = 0
+    deadline = time.time() + args.duration
+
+    while time.time() < deadline:
+        op = rng.choices(OPS, weights=weights)[0]
+        start = time.perf_counter()
+        if op == "cache":
+            key = rng.choice(keys)
+            if rng.random() < 0.5:
+                utils._save_cache(key, _payload(key, worker, counts[op], args.payload))
+            else:
+                cached = utils._load_cache(key)
+                if cached is None:
+                    violations.append({"op": op, "kind": "torn_or_missing_cache", "key": key})
+                elif not _payload_ok(cached, key):
+                    violations.append({"op": op, "kind": "corrupt_cache", "key": key})
+        elif op == "state":
+            state = utils.load_state(state_file)
+            if state.mode != "custom":
+                violations.append({"op": op, "kind": "torn_state"})
+            else:
+                state.iteration += 1
+                state.history = (state.history + [{"w": worker, "n": increments}])[-50:]
+                utils.save_state(state, state_file)
+                increments += 1
+        elif op == "usage":
+            utils._log_usage("stress:usage", "stub", None, 10, 10, 0.0,
+                             extra={"stress_worker": worker, "seq": usage_seq})
+            usage_seq += 1
+        else:
+            prompt = f"stress prompt {rng.randrange(args.keys)}"
+            output, code = utils.run_cli("stub", prompt, timeout=60, show_output=False,
+                                         usage_label="stress:run_cli")
+            digest = hashlib.sha256(prompt.encode()).hexdigest()
+            if code != 0 or f"STUB-DIGEST: {digest}" not in output:
+                violations.append({"op": op, "kind": "bad_cli_output", "code": code})
+        seconds[op] += time.perf_counter() - start
+        counts[op] += 1
+
+    return {"worker": worker, "counts": counts, "seconds": seconds, "violations": violations,
+            "state_increments": increments, "usage_logged": usage_seq}
+
+
+# ============================================================================
+# DRIVER
+# ============================================================================
+
+def prepare_workspace(workspace: Path, args):
+    sys.path.insert(0, str(CONTROLLER_DIR))
+    import utils
+
+    state_dir = workspace / "state"
+    if state_dir.exists():
+        for name in (SHARED_STATE, "usage.jsonl"):
+            (state_dir / name).unlink(missing_ok=True)
+    utils.CACHE_DIR = state_dir / "cache"
+    for k in range(args.keys):
+        key = f"stress:key{k}"
+        utils._save_cache(key, _payload(key, -1, 0, args.payload))
+    utils.save_state(utils.LoopState(mode="custom"), state_dir / SHARED_STATE)
+
+
+def verify(workspace: Path, reports: list[dict]) -> list[dict]:
+    """Cross-process checks: lost state updates and usage log integrity."""
+    violations = []
+    state_file = workspace / "state" / SHARED_STATE
+    expected = sum(r["state_increments"] for r in reports)
+    try:
+        final = json.loads(state_file.read_text()).get("iteration", 0)
+        if final != expected:
+            violations.append({"op": "state", "kind": "lost_updates", "count": expected - final})
+    except ValueError:
+        violations.append({"op": "state", "kind": "torn_state_final"})
+
+    seen: dict[tuple[int, int], int] = {}
+    malformed = 0
+    usage_log = workspace / "state" / "usage.jsonl"
+    for line in usage_log.read_text().splitlines() if usage_log.exists() else []:
+        try:
+            record = json.loads(line)
+        except ValueError:
+            malformed += 1
+            continue
+        if record.get("label") == "stress:usage":
+            key = (record.get("stress_worker"), record.get("seq"))
+            seen[key] = seen.get(key, 0) + 1
+    expected_keys = {(r["worker"], n) for r in reports for n in range(r["usage_logged"])}
+    missing = len(expected_keys - set(seen))
+    duplicates = sum(c - 1 for c in seen.values() if c > 1)
+    if malformed:
+        violations.append({"op": "usage", "kind": "malformed_lines", "count": malformed})
+    if missing:
+        violations.append({"op": "usage", "kind": "missing_records", "count": missing})
+    if duplicates:
+        violations.append({"op": "usage", "kind": "duplicate_records", "count": duplicates})
+    return violations
+
+
+def print_report(reports: list[dict], violations: list[dict], args, wall: float):
+    print()
+    print(f"{Colors.CYAN}═══ Concurrency Stress ({args.processes} processes, {args.duration:.0f}s) ═══{Colors.RESET}")
+    print(f"  {'operation':<10} {'ops':>9} {'ops/sec':>10} {'mean':>10}")
+    for op in OPS:
+        count = sum(r["counts"][op] for r in reports)
+        sec = sum(r["seconds"][op] for r in reports)
+        mean = f"{sec / count * 1e3:.2f}ms" if count else "—"
+        print(f"  {op:<10} {count:>9} {count / wall:>10.1f} {mean:>10}")
+
+    by_kind: dict[str, int] = {}
+    for v in violations:
+        by_kind[f"{v['op']}:{v['kind']}"] = by_kind.get(f"{v['op']}:{v['kind']}", 0) + v.get("count", 1)
+    print()
+    if not by_kind:
+        print(f"  {Colors.GREEN}No integrity violations{Colors.RESET}")
+    for kind, count in sorted(by_kind.items()):
+        print(f"  {Colors.RED}✗ {kind}: {count}{Colors.RESET}")
+    print()
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Multi-process stress test for shared orchestrator state")
+    parser.add_argument("--processes", "-n", type=int, default=8)
+    parser.add_argument("--duration", type=float, default=10.0, help="Seconds each process runs")
+    parser.add_argument("--keys", type=int, default=16, help="Distinct cache keys shared by all processes")
+    parser.add_argument("--payload", type=int, default=64 * 1024, help="Cache payload size in bytes")
+    parser.add_argument("--mix", default="4,3,3,1", help="Relative weights for cache,state,usage,run_cli")
+    parser.add_argument("--workspace", help="Workspace directory (default: a temporary directory)")
+    parser.add_argument("--seed", type=int, default=0)
+    parser.add_argument("--json", action="store_true")
+    parser.add_argument("--worker", type=int, help=argparse.SUPPRESS)
+    args = parser.parse_args()
+
+    if args.worker is not None:
+        print(json.dumps(run_worker(args.worker, args)))
+        return
+
+    tmp = None if args.workspace else tempfile.TemporaryDirectory(prefix="stress-")
+    workspace = Path(args.workspace or tmp.name).resolve()
+    workspace.mkdir(parents=True, exist_ok=True)
+    prepare_workspace(workspace, args)
+
+    env = {k: v for k, v in os.environ.items() if k not in ("TRACER_WORKSPACE", "ORCHESTRATOR_WORKSPACE")}
+    env["ORCHESTRATOR_CACHE"] = "1"
+    worker_argv = [sys.executable, str(Path(__file__).resolve()), "--duration", str(args.duration),
+                   "--keys", str(args.keys), "--payload", str(args.payload), "--mix", args.mix,
+                   "--seed", str(args.seed)]
+    started = time.time()
+    procs = [subprocess.Popen(worker_argv + ["--worker", str(i)], cwd=str(workspace), env=env,
+                              stdout=subprocess.PIPE, text=True)
+             for i in range(args.processes)]
+    reports = []
+    for proc in procs:
+        out, _ = proc.communicate()
+        # run_cli prints usage lines; the report is the last line
+        reports.append(json.loads(out.strip().splitlines()[-1]))
+    wall = time.time() - started
+
+    violations = [v for r in reports for v in r["violations"]] + verify(workspace, reports)
+    if args.json:
+        print(json.dumps({"processes": args.processes, "wall_sec": wall, "reports": reports,
+                          "violations": violations}, indent=2))
+    else:
+        print_report(reports, violations, args, wall)
+    if tmp:
+        tmp.cleanup()
+    sys.exit(1 if violations else 0)
+
+
+if __name__ == "__main__":
+    main()
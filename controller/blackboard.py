@@ -0,0 +1,106 @@
+#!/usr/bin/env python3
+"""
+Run-Scoped Blackboard
+
+Append-only findings store shared by the agents of one parallel run:
+- Findings carry a file:line reference, a note and the posting agent
+- Agents query it through their prompt and the shared tool server
+- Agents post via the tool server or `FINDING:` lines in their output
+"""
+from __future__ import annotations
+
+import os
+import re
+import json
+import threading
+from pathlib import Path
+from datetime import datetime
+from typing import Optional
+
+try:
+    from .utils import STATE_DIR, compact_text, note_prompt_section
+except ImportError:
+    from utils import STATE_DIR, compact_text, note_prompt_section
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+BLACKBOARD_DIR = STATE_DIR / "blackboard"
+PROMPT_MAX_CHARS = 3000
+
+FINDING_RE = re.compile(r'^\s*[-*]?\s*FINDING:\s*(\S+?:\d+)\s*(?:[-—:]\s*)?(.+)$', re.MULTILINE)
+
+
+def blackboard_enabled() -> bool:
+    return os.getenv("ORCHESTRATOR_BLACKBOARD") == "1"
+
+
+# ============================================================================
+# BLACKBOARD
+# ============================================================================
+
+class Blackboard:
+    """Append-only findings log for a single run."""
+
+    def __init__(self, run_id: Optional[str] = None):
+        self.run_id = run_id or datetime.now().strftime("%Y%m%d-%H%M%S")
+        self.path = BLACKBOARD_DIR / f"{self.run_id}.jsonl"
+        self.lock = threading.Lock()
+        self.findings: list[dict] = []
+        if self.path.exists():
+            for line in self.path.read_text().splitlines():
+                try:
+                    self.findings.append(json.loads(line))
+                except ValueError:
+                    continue
+
+    def post(self, agent: str, ref: str, note: str) -> dict:
+        finding = {
+            "ts": datetime.now().isoformat(),
+            "agent": agent,
+            "ref": ref.strip(),
+            "note": note.strip(),
+        }
+        with self.lock:
+            if any(f["ref"] == finding["ref"] and f["note"] == finding["note"] for f in self.findings):
+                return finding
+            self.findings.append(finding)
+            self.path.parent.mkdir(parents=True, exist_ok=True)
+            with self.path.open("a", encoding="utf-8") as f:
+                f.write(json.dumps(finding) + "\n")
+        return finding
+
+    def query(self, term: Optional[str] = None, limit: int = 50) -> list[dict]:
+        with self.lock:
+            findings = list(self.findings)
+        if term:
+            needle = term.lower()
+            findings = [f for f in findings if needle in f["ref"].lower() or needle in f["note"].lower()]
+        return findings[-limit:]
+
+    def ingest(self, agent: str, output: str) -> int:
+        """Record `FINDING: path:line — note` lines from an agent's output."""
+        count = 0
+        for ref, note in FINDING_RE.findall(output or ""):
+            self.post(agent, ref, note)
+            count += 1
+        return count
+
+    def render(self, findings: Optional[list[dict]] = None) -> str:
+        findings = self.query() if findings is None else findings
+        lines = [f"- {f['ref']} — {f['note']} ({f['agent']})" for f in findings]
+        return compact_text("\n".join(lines), PROMPT_MAX_CHARS)
+
+    def prompt_section(self, tools_available: bool = False) -> str:
+        known = self.render() or "(none yet)"
+        note_prompt_section("blackboard", known)
+        how = ("call `post_finding` / `query_findings`, or " if tools_available else "")
+        return f'''
+## Shared Findings (other agents in this run)
+{known}
+
+Skip ground already covered above. To share a finding, {how}emit one line per finding:
+FINDING: <file>:<line> — <one-line note>
+'''
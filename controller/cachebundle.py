@@ -0,0 +1,240 @@
+#!/usr/bin/env python3
+"""
+Cache Bundles
+
+Move CLI output cache entries between workspaces, e.g. to start CI warm:
+- Export selected state/cache entries by label prefix, age and hit count
+  (hits come from the ":cache" records in usage.jsonl; entries are immutable)
+- Single tar.gz with a manifest of per-entry sha256 digests
+- Import verifies every entry before merging; newer local entries win
+"""
+from __future__ import annotations
+
+import io
+import json
+import time
+import tarfile
+import hashlib
+from datetime import datetime
+from pathlib import Path
+from typing import Optional
+
+try:
+    from .utils import Colors, CACHE_DIR, _write_cache_entry, load_usage_records
+    from .scheduler import DURATION_RE, DURATION_UNITS
+except ImportError:
+    from utils import Colors, CACHE_DIR, _write_cache_entry, load_usage_records
+    from scheduler import DURATION_RE, DURATION_UNITS
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+BUNDLE_VERSION = 1
+MANIFEST_NAME = "manifest.json"
+ENTRY_DIR = "entries"
+
+
+class BundleError(Exception):
+    pass
+
+
+def _parse_age(text: Optional[str]) -> Optional[float]:
+    """"7d", "12h" -> seconds."""
+    if not text:
+        return None
+    match = DURATION_RE.match(text)
+    if not match:
+        raise BundleError(f"invalid age '{text}' (use e.g. 90m, 12h, 7d)")
+    return float(match.group(1)) * DURATION_UNITS[match.group(2)]
+
+
+def _entry_ts(data: dict) -> float:
+    try:
+        return datetime.fromisoformat(data.get("ts", "")).timestamp()
+    except ValueError:
+        return 0.0
+
+
+def hit_times(records: Optional[list[dict]] = None) -> dict[str, list[str]]:
+    """Cache key -> timestamps of its hits, from the usage records run_cli logs on a hit."""
+    hits: dict[str, list[str]] = {}
+    for r in load_usage_records() if records is None else records:
+        if r.get("cache_key") and r.get("label", "").endswith(":cache"):
+            hits.setdefault(r["cache_key"], []).append(r.get("ts", ""))
+    return hits
+
+
+def entry_hits(data: dict, hits: dict[str, list[str]]) -> int:
+    # Only hits since the entry was (re)written count toward it
+    return sum(1 for ts in hits.get(data.get("key") or "", []) if ts >= data.get("ts", ""))
+
+
+# ============================================================================
+# EXPORT
+# ============================================================================
+
+def select_entries(cache_dir: Path = CACHE_DIR, labels: Optional[list[str]] = None,
+                   max_age: Optional[float] = None, min_hits: int = 0) -> list[tuple[Path, bytes, dict]]:
+    """Cache files matching every filter, as (path, raw bytes, parsed entry)."""
+    now = time.time()
+    hits = hit_times() if min_hits else {}
+    selected = []
+    for path in sorted(cache_dir.glob("*.json")) if cache_dir.exists() else []:
+        try:
+            raw = path.read_bytes()
+            data = json.loads(raw)
+        except (OSError, ValueError):
+            continue
+        # Entries written before labels were recorded only match an unfiltered export
+        if labels and not any((data.get("label") or "").startswith(l) for l in labels):
+            continue
+        if max_age is not None and now - _entry_ts(data) > max_age:
+            continue
+        if min_hits and entry_hits(data, hits) < min_hits:
+            continue
+        selected.append((path, raw, data))
+    return selected
+
+
+def export_bundle(bundle: Path, cache_dir: Path = CACHE_DIR, labels: Optional[list[str]] = None,
+                  max_age: Optional[float] = None, min_hits: int = 0) -> dict:
+    entries = select_entries(cache_dir, labels, max_age, min_hits)
+    hits = hit_times()
+    manifest = {
+        "version": BUNDLE_VERSION,
+        "created": datetime.now().isoformat(timespec="seconds"),
+        "filters": {"labels": labels, "max_age_sec": max_age, "min_hits": min_hits},
+        "entries": [{
+            "name": path.name,
+            "label": data.get("label"),
+            "ts": data.get("ts"),
+            "hits": entry_hits(data, hits),
+            "bytes": len(raw),
+            "sha256": hashlib.sha256(raw).hexdigest(),
+        } for path, raw, data in entries],
+    }
+
+    bundle.parent.mkdir(parents=True, exist_ok=True)
+    tmp = bundle.with_name(f".{bundle.name}.tmp")
+    with tarfile.open(tmp, "w:gz") as tar:
+        def add(name: str, payload: bytes):
+            info = tarfile.TarInfo(name)
+            info.size = len(payload)
+            info.mtime = int(time.time())
+            tar.addfile(info, io.BytesIO(payload))
+
+        add(MANIFEST_NAME, json.dumps(manifest, indent=2).encode("utf-8"))
+        for path, raw, _ in entries:
+            add(f"{ENTRY_DIR}/{path.name}", raw)
+    tmp.replace(bundle)
+    return manifest
+
+
+# ============================================================================
+# IMPORT
+# ============================================================================
+
+def read_bundle(bundle: Path) -> tuple[dict, dict[str, bytes]]:
+    """Manifest and verified entry payloads; raises BundleError on any mismatch."""
+    try:
+        tar = tarfile.open(bundle, "r:gz")
+    except (OSError, tarfile.TarError) as e:
+        raise BundleError(f"cannot open {bundle}: {e}")
+    with tar:
+        members = {m.name: m for m in tar.getmembers() if m.isfile()}
+        if MANIFEST_NAME not in members:
+            raise BundleError("bundle has no manifest")
+        try:
+            manifest = json.loads(tar.extractfile(members[MANIFEST_NAME]).read())
+        except ValueError:
+            raise BundleError("manifest is not valid JSON")
+        if manifest.get("version") != BUNDLE_VERSION:
+            raise BundleError(f"unsupported bundle version {manifest.get('version')}")
+
+        payloads = {}
+        for entry in manifest.get("entries", []):
+            name = entry.get("name", "")
+            # Names become file names in the cache; never follow paths out of it
+            if not name.endswith(".json") or "/" in name or "\\" in name or name.startswith("."):
+                raise BundleError(f"invalid entry name '{name}'")
+            member = members.get(f"{ENTRY_DIR}/{name}")
+            if member is None:
+                raise BundleError(f"entry {name} missing from bundle")
+            raw = tar.extractfile(member).read()
+            if hashlib.sha256(raw).hexdigest() != entry.get("sha256"):
+                raise BundleError(f"entry {name} failed its sha256 check")
+            payloads[name] = raw
+    return manifest, payloads
+
+
+def import_bundle(bundle: Path, cache_dir: Path = CACHE_DIR, overwrite: bool = False) -> dict:
+    """Merge a verified bundle into the cache; returns counts per outcome."""
+    manifest, payloads = read_bundle(bundle)
+    counts = {"imported": 0, "kept_local": 0, "invalid": 0}
+    for name, raw in payloads.items():
+        try:
+            incoming = json.loads(raw)
+        except ValueError:
+            counts["invalid"] += 1
+            continue
+        target = cache_dir / name
+        if target.exists() and not overwrite:
+            try:
+                local = json.loads(target.read_text())
+                if _entry_ts(local) >= _entry_ts(incoming):
+                    counts["kept_local"] += 1
+                    continue
+            except ValueError:
+                pass
+        # Entries written before hits moved to usage.jsonl may still carry a count
+        incoming.pop("hits", None)
+        incoming["imported_from"] = manifest.get("created")
+        _write_cache_entry(target, incoming)
+        counts["imported"] += 1
+    return counts
+
+
+# ============================================================================
+# CLI
+# ============================================================================
+
+def run_cache(args):
+    try:
+        if args.action == "export":
+            labels = [l.strip() for l in (args.label or "").split(",") if l.strip()] or None
+            manifest = export_bundle(Path(args.bundle), labels=labels, max_age=_parse_age(args.max_age),
+                                     min_hits=args.min_hits)
+            size = Path(args.bundle).stat().st_size
+            digest = hashlib.sha256(Path(args.bundle).read_bytes()).hexdigest()
+            print(f"  {Colors.GREEN}✓{Colors.RESET} {len(manifest['entries'])} entries → {args.bundle} "
+                  f"({size / 1024:.1f} KiB, sha256 {digest[:16]})")
+        else:
+            counts = import_bundle(Path(args.bundle), overwrite=args.overwrite)
+            print(f"  {Colors.GREEN}✓{Colors.RESET} imported {counts['imported']}, "
+                  f"kept {counts['kept_local']} newer local, skipped {counts['invalid']} invalid → {CACHE_DIR}")
+    except BundleError as e:
+        print(f"  {Colors.RED}[cache]{Colors.RESET} {e}")
+        raise SystemExit(1)
+
+
+def add_arguments(parser):
+    parser.add_argument("action", choices=["export", "import"])
+    parser.add_argument("bundle", help="Bundle path (.tar.gz)")
+    parser.add_argument("--label", help="Export only these label prefixes (comma-separated)")
+    parser.add_argument("--max-age", help="Export only entries newer than this (e.g. 12h, 7d)")
+    parser.add_argument("--min-hits", type=int, default=0, help="Export only entries reused this often")
+    parser.add_argument("--overwrite", action="store_true", help="Import over newer local entries")
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Export/import CLI cache bundles")
+    add_arguments(parser)
+    run_cache(parser.parse_args())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,228 @@
+#!/usr/bin/env python3
+"""
+Cost Attribution
+
+Rolls usage.jsonl up the attribution tree stamped by run_cli:
+- story/spec → ticket → task → phase (label) → call
+- Tokens, estimated dollars and agent-seconds per node
+- Flat ranking by one level ("which ticket cost the most?")
+- Folded-stack export for flamegraph.pl / speedscope
+"""
+from __future__ import annotations
+
+from datetime import datetime
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import Optional
+
+try:
+    from .utils import Colors, USAGE_LOG, load_usage_records, estimate_cost, model_prices
+    from .simulator import base_label
+except ImportError:
+    from utils import Colors, USAGE_LOG, load_usage_records, estimate_cost, model_prices
+    from simulator import base_label
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+UNATTRIBUTED = "unattributed"
+METRICS = ("cost", "tokens", "seconds")
+# Folded stacks need integer weights: micro-dollars, tokens, milliseconds
+FOLDED_SCALE = {"cost": 1_000_000, "tokens": 1, "seconds": 1000}
+
+
+# ============================================================================
+# TREE
+# ============================================================================
+
+@dataclass
+class Node:
+    name: str
+    calls: int = 0
+    tokens: int = 0
+    cost: float = 0.0
+    seconds: float = 0.0
+    children: dict[str, "Node"] = field(default_factory=dict)
+
+    def add(self, tokens: int, cost: float, seconds: float):
+        self.calls += 1
+        self.tokens += tokens
+        self.cost += cost
+        self.seconds += seconds
+
+    def child(self, name: str) -> "Node":
+        if name not in self.children:
+            self.children[name] = Node(name)
+        return self.children[name]
+
+
+def record_path(record: dict, calls: bool = False) -> list[str]:
+    """Attribution nodes, then the phase label, then (optionally) the call itself."""
+    path = list(record.get("attribution") or [UNATTRIBUTED])
+    path.append(base_label(record.get("label", "?")))
+    if calls:
+        path.append(f"call@{record.get('ts', '?')}")
+    return path
+
+
+def record_values(record: dict, prices: dict) -> tuple[int, float, float]:
+    tokens = int(record.get("total_tokens", 0))
+    # Cache hits cost nothing and take no agent time
+    if record.get("label", "").endswith(":cache"):
+        return tokens, 0.0, 0.0
+    cost = estimate_cost(record.get("model"), record.get("in_tokens", 0), record.get("out_tokens", 0), prices)
+    return tokens, cost, float(record.get("elapsed_sec", 0.0))
+
+
+def filter_records(records: list[dict], days: Optional[int] = None, under: Optional[str] = None) -> list[dict]:
+    cutoff = datetime.now().timestamp() - days * 86400 if days else None
+    kept = []
+    for r in records:
+        if under and under not in (r.get("attribution") or []):
+            continue
+        if cutoff is not None:
+            try:
+                if datetime.fromisoformat(r.get("ts", "")).timestamp() < cutoff:
+                    continue
+            except ValueError:
+                continue
+        kept.append(r)
+    return kept
+
+
+def build_tree(records: list[dict], calls: bool = False) -> Node:
+    prices = model_prices()
+    root = Node("all")
+    for r in records:
+        values = record_values(r, prices)
+        node = root
+        node.add(*values)
+        for name in record_path(r, calls):
+            node = node.child(name)
+            node.add(*values)
+    return root
+
+
+def rank_by(records: list[dict], kind: str) -> list[Node]:
+    """Flat totals per value of one attribution level (e.g. every ticket)."""
+    prices = model_prices()
+    totals: dict[str, Node] = {}
+    for r in records:
+        nodes = [n for n in r.get("attribution") or [] if n.startswith(f"{kind}=")]
+        name = nodes[0] if nodes else f"{kind}=(none)"
+        totals.setdefault(name, Node(name)).add(*record_values(r, prices))
+    return list(totals.values())
+
+
+def folded_stacks(records: list[dict], metric: str = "cost", calls: bool = False) -> list[str]:
+    """Lines of "frame;frame;frame weight" aggregated by stack."""
+    prices = model_prices()
+    weights: dict[str, float] = {}
+    for r in records:
+        tokens, cost, seconds = record_values(r, prices)
+        value = {"cost": cost, "tokens": tokens, "seconds": seconds}[metric] * FOLDED_SCALE[metric]
+        stack = ";".join(p.replace(";", ":").replace(" ", "_") for p in record_path(r, calls))
+        weights[stack] = weights.get(stack, 0) + value
+    return [f"{stack} {round(w)}" for stack, w in sorted(weights.items()) if round(w) > 0]
+
+
+# ============================================================================
+# REPORT
+# ============================================================================
+
+def _fmt_tokens(n: int) -> str:
+    if n >= 1_000_000:
+        return f"{n / 1_000_000:.1f}M"
+    if n >= 1_000:
+        return f"{n / 1_000:.1f}k"
+    return str(n)
+
+
+def _row(node: Node, label: str, total: Node, metric: str) -> str:
+    share = getattr(node, metric) / getattr(total, metric) if getattr(total, metric) else 0.0
+    return (f"  {'$' + format(node.cost, ',.2f'):>10} {_fmt_tokens(node.tokens):>8} {node.seconds:>9.0f}s "
+            f"{node.calls:>6} {share:>6.1%}  {label}")
+
+
+def print_tree(root: Node, metric: str = "cost", depth: int = 4, min_share: float = 0.01):
+    print(f"  {'cost':>10} {'tokens':>8} {'agent-sec':>10} {'calls':>6} {'share':>6}  node")
+    print(_row(root, "all", root, metric))
+
+    def walk(node: Node, level: int):
+        if level > depth:
+            return
+        children = sorted(node.children.values(), key=lambda n: getattr(n, metric), reverse=True)
+        hidden = 0
+        for child in children:
+            total = getattr(root, metric)
+            if total and getattr(child, metric) / total < min_share:
+                hidden += 1
+                continue
+            print(_row(child, "  " * level + child.name, root, metric))
+            walk(child, level + 1)
+        if hidden:
+            print(f"  {Colors.GRAY}{'':>46}{'  ' * level}… {hidden} smaller node(s){Colors.RESET}")
+
+    walk(root, 1)
+
+
+def run_report(args):
+    records = filter_records(load_usage_records(), args.days, args.under)
+    if not records:
+        print(f"{Colors.YELLOW}No usage records in {USAGE_LOG}{Colors.RESET}")
+        return
+
+    if args.folded:
+        lines = folded_stacks(records, args.metric, args.calls)
+        Path(args.folded).write_text("\n".join(lines) + "\n")
+        print(f"  {Colors.GREEN}✓{Colors.RESET} {len(lines)} stacks ({args.metric}) → {args.folded}")
+        print(f"  {Colors.GRAY}render: flamegraph.pl {args.folded} > cost.svg{Colors.RESET}")
+        return
+
+    print()
+    print(f"{Colors.CYAN}═══ Cost Attribution ({len(records)} calls) ═══{Colors.RESET}")
+    print()
+    if args.by:
+        nodes = sorted(rank_by(records, args.by), key=lambda n: getattr(n, args.metric), reverse=True)
+        total = Node("all")
+        for n in nodes:
+            total.calls += n.calls
+            total.tokens += n.tokens
+            total.cost += n.cost
+            total.seconds += n.seconds
+        print(f"  {'cost':>10} {'tokens':>8} {'agent-sec':>10} {'calls':>6} {'share':>6}  {args.by}")
+        for n in nodes[: args.limit]:
+            print(_row(n, n.name, total, args.metric))
+    else:
+        print_tree(build_tree(records, args.calls), args.metric, args.depth, args.min_share)
+    unattributed = sum(1 for r in records if not r.get("attribution"))
+    if unattributed:
+        print(f"\n  {Colors.GRAY}{unattributed} call(s) without attribution (recorded before it "
+              f"existed, or outside a story/ticket){Colors.RESET}")
+    print()
+
+
+def add_arguments(parser):
+    parser.add_argument("--by", help="Rank one level instead of the tree (story, spec, ticket, task, step)")
+    parser.add_argument("--metric", choices=METRICS, default="cost", help="Sort and share by this metric")
+    parser.add_argument("--depth", type=int, default=4, help="Tree depth to print")
+    parser.add_argument("--min-share", type=float, default=0.01, help="Hide nodes below this share")
+    parser.add_argument("--under", help="Only calls under this node, e.g. ticket=TKT-1A2B")
+    parser.add_argument("--days", type=int, help="Only the last N days")
+    parser.add_argument("--calls", action="store_true", help="Include individual calls as leaves")
+    parser.add_argument("--limit", type=int, default=20)
+    parser.add_argument("--folded", help="Write folded stacks for a flamegraph to this file")
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Cost attribution report")
+    add_arguments(parser)
+    run_report(parser.parse_args())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,264 @@
+#!/usr/bin/env python3
+"""
+Live Agent Dashboard
+
+Curses view of concurrent agents, fed by run_cli events (CLI_LISTENERS):
+- One row per active agent: label, model, elapsed, idle time, lines/sec,
+  estimated tokens and last output line
+- Aggregate throughput, completed calls and queue depth
+- Falls back to the plain interleaved log when stdout is not a TTY
+- Steps aside while the run asks questions on the terminal (prompting())
+"""
+from __future__ import annotations
+
+import os
+import sys
+import time
+import atexit
+import threading
+from contextlib import contextmanager
+from dataclasses import dataclass
+from typing import Optional
+
+try:
+    from .utils import Colors, STATE_DIR, CLI_LISTENERS
+except ImportError:
+    from utils import Colors, STATE_DIR, CLI_LISTENERS
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+DASHBOARD_LOG = STATE_DIR / "dashboard.log"
+REFRESH_SEC = 0.5
+STALL_SEC = 60.0
+THROUGHPUT_WINDOW_SEC = 10.0
+
+
+def dashboard_enabled() -> bool:
+    return os.getenv("ORCHESTRATOR_DASHBOARD") == "1"
+
+
+# ============================================================================
+# STATE
+# ============================================================================
+
+@dataclass
+class AgentRow:
+    id: int
+    label: str
+    model: Optional[str]
+    started: float
+    last_output: float
+    lines: int = 0
+    chars: int = 0
+    last_line: str = ""
+
+
+class DashboardState:
+    """Folds the event stream into per-agent rows and aggregates."""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.rows: dict[int, AgentRow] = {}
+        self.completed = 0
+        self.failed = 0
+        self.queue = 0
+        self.out_chars = 0
+        self.recent: list[tuple[float, int]] = []  # (ts, chars) for the throughput window
+        self.started = time.time()
+
+    def on_event(self, event: dict):
+        ts = event["ts"]
+        with self.lock:
+            kind = event["type"]
+            if kind == "start":
+                self.rows[event["id"]] = AgentRow(event["id"], event.get("label", "?"),
+                                                  event.get("model"), ts, ts)
+            elif kind == "line":
+                row = self.rows.get(event["id"])
+                if row:
+                    line = event.get("line", "")
+                    row.lines += 1
+                    row.chars += len(line) + 1
+                    row.last_output = ts
+                    if line.strip():
+                        row.last_line = line.strip()
+                    self.out_chars += len(line) + 1
+                    self.recent.append((ts, len(line) + 1))
+            elif kind == "end":
+                if self.rows.pop(event["id"], None) is not None:
+                    self.completed += 1
+                    self.failed += event.get("code", 0) != 0
+            elif kind == "queue":
+                self.queue = event.get("pending", 0)
+
+    def snapshot(self, now: float) -> tuple[list[AgentRow], dict]:
+        with self.lock:
+            self.recent = [(ts, c) for ts, c in self.recent if now - ts <= THROUGHPUT_WINDOW_SEC]
+            window_chars = sum(c for _, c in self.recent)
+            rows = sorted(self.rows.values(), key=lambda r: r.started)
+            totals = {
+                "active": len(rows),
+                "completed": self.completed,
+                "failed": self.failed,
+                "queue": self.queue,
+                "lines_per_sec": len(self.recent) / THROUGHPUT_WINDOW_SEC,
+                "tokens_per_sec": window_chars / 4 / THROUGHPUT_WINDOW_SEC,
+                "out_tokens": self.out_chars // 4,
+                "uptime": now - self.started,
+            }
+            return [AgentRow(**r.__dict__) for r in rows], totals
+
+
+# ============================================================================
+# CURSES VIEW
+# ============================================================================
+
+def _fmt_sec(sec: float) -> str:
+    sec = int(sec)
+    return f"{sec // 60}m{sec % 60:02d}s" if sec >= 60 else f"{sec}s"
+
+
+class CursesDashboard:
+    """Renders DashboardState from a background thread; stdout goes to a log meanwhile."""
+
+    def __init__(self, state: DashboardState):
+        self.state = state
+        self.stop_event = threading.Event()
+        self.thread: Optional[threading.Thread] = None
+        self.saved_stdout = None
+        self.log = None
+
+    def start(self):
+        import curses
+
+        DASHBOARD_LOG.parent.mkdir(parents=True, exist_ok=True)
+        self.log = DASHBOARD_LOG.open("a", encoding="utf-8")
+        self.saved_stdout = sys.stdout
+        sys.stdout = self.log
+        self.screen = curses.initscr()
+        curses.noecho()
+        curses.curs_set(0)
+        if curses.has_colors():
+            curses.start_color()
+            curses.use_default_colors()
+            curses.init_pair(1, curses.COLOR_CYAN, -1)
+            curses.init_pair(2, curses.COLOR_RED, -1)
+            curses.init_pair(3, curses.COLOR_GREEN, -1)
+        self._spawn()
+
+    def _spawn(self):
+        self.stop_event.clear()
+        self.thread = threading.Thread(target=self._loop, name="dashboard", daemon=True)
+        self.thread.start()
+
+    def suspend(self):
+        """Hand the terminal back (plain stdout, echo on) without ending the session."""
+        if not self.thread:
+            return
+        import curses
+
+        self.stop_event.set()
+        self.thread.join(timeout=2)
+        self.thread = None
+        curses.endwin()
+        sys.stdout = self.saved_stdout
+
+    def resume(self):
+        if self.thread or self.log.closed:
+            return
+        self.saved_stdout = sys.stdout
+        sys.stdout = self.log
+        # The first refresh after endwin() puts the terminal back in curses mode
+        self.screen.clear()
+        self.screen.refresh()
+        self._spawn()
+
+    def stop(self):
+        if not self.log or self.log.closed:
+            return
+        self.suspend()
+        self.log.close()
+        _, totals = self.state.snapshot(time.time())
+        print(f"  {Colors.GRAY}[dashboard]{Colors.RESET} {totals['completed']} calls "
+              f"({totals['failed']} failed), ~{totals['out_tokens']} output tokens; log: {DASHBOARD_LOG}")
+
+    def _loop(self):
+        while not self.stop_event.is_set():
+            try:
+                self._render()
+            except Exception:
+                pass
+            self.stop_event.wait(REFRESH_SEC)
+
+    def _render(self):
+        import curses
+
+        now = time.time()
+        rows, totals = self.state.snapshot(now)
+        height, width = self.screen.getmaxyx()
+        scr = self.screen
+        scr.erase()
+
+        header = (f" Agents {totals['active']} active · {totals['completed']} done · "
+                  f"{totals['failed']} failed · queue {totals['queue']} · "
+                  f"{totals['lines_per_sec']:.1f} lines/s · {totals['tokens_per_sec']:.0f} tok/s · "
+                  f"up {_fmt_sec(totals['uptime'])}")
+        scr.addnstr(0, 0, header, width - 1, curses.color_pair(1) | curses.A_BOLD)
+        columns = f" {'label':<28} {'model':<18} {'elapsed':>8} {'idle':>7} {'lines/s':>7} {'~tok':>7}  last output"
+        scr.addnstr(2, 0, columns, width - 1, curses.A_DIM)
+
+        for i, row in enumerate(rows[: max(0, height - 4)]):
+            elapsed = now - row.started
+            idle = now - row.last_output
+            rate = row.lines / elapsed if elapsed > 0 else 0.0
+            line = (f" {row.label[:28]:<28} {(row.model or '-')[:18]:<18} {_fmt_sec(elapsed):>8} "
+                    f"{_fmt_sec(idle):>7} {rate:>7.1f} {row.chars // 4:>7}  {row.last_line}")
+            attr = curses.color_pair(2) if idle > STALL_SEC else 0
+            scr.addnstr(3 + i, 0, line, width - 1, attr)
+        if not rows:
+            scr.addnstr(3, 0, " waiting for agents...", width - 1, curses.A_DIM)
+        scr.refresh()
+
+
+_dashboard: Optional[CursesDashboard] = None
+
+
+def start_dashboard() -> Optional[CursesDashboard]:
+    """Start the live view (idempotent); keeps plain log output when not on a TTY."""
+    global _dashboard
+    if _dashboard is not None:
+        return _dashboard
+    if not (sys.stdout.isatty() and sys.stdin.isatty()) or os.getenv("TERM") in (None, "", "dumb"):
+        print(f"  {Colors.GRAY}[dashboard]{Colors.RESET} not a terminal; using plain log output")
+        return None
+    state = DashboardState()
+    CLI_LISTENERS.append(state.on_event)
+    _dashboard = CursesDashboard(state)
+    try:
+        _dashboard.start()
+    except Exception as e:
+        CLI_LISTENERS.remove(state.on_event)
+        if _dashboard.saved_stdout:
+            sys.stdout = _dashboard.saved_stdout
+        _dashboard = None
+        print(f"  {Colors.YELLOW}[dashboard]{Colors.RESET} unavailable ({e}); using plain log output")
+        return None
+    atexit.register(_dashboard.stop)
+    return _dashboard
+
+
+@contextmanager
+def prompting():
+    """Show questions and read input() on the real terminal; the live view resumes afterwards."""
+    dashboard = _dashboard
+    if dashboard is None:
+        yield
+        return
+    dashboard.suspend()
+    try:
+        yield
+    finally:
+        dashboard.resume()
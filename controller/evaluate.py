@@ -0,0 +1,450 @@
+#!/usr/bin/env python3
+"""
+Model Evaluation Harness
+
+Offline replay of recorded prompts against candidate models, per label:
+- Corpus recorded by run_cli (ORCHESTRATOR_EVAL_RECORD) with reference outputs
+- Label-specific checks: schema validity, agreement with the reference
+  decision, score deltas for graders
+- Per-label quality / cost / latency table with the Pareto front marked,
+  to pick cheap_model and ORCHESTRATOR_CHEAP_LABELS from data
+- Replays run in a throwaway copy of the workspace unless asked otherwise
+"""
+from __future__ import annotations
+
+import os
+import re
+import json
+import random
+import shutil
+import tempfile
+import statistics
+from pathlib import Path
+from datetime import datetime
+from concurrent.futures import ThreadPoolExecutor
+from dataclasses import dataclass
+from typing import Optional, Callable
+
+try:
+    from .utils import (
+        Colors, WORKSPACE, STATE_DIR, EVAL_CORPUS, CLI_CONFIGS,
+        run_cli, extract_score, estimate_cost, _estimate_tokens,
+    )
+    from .stepplan import WorktreeSet
+except ImportError:
+    from utils import (
+        Colors, WORKSPACE, STATE_DIR, EVAL_CORPUS, CLI_CONFIGS,
+        run_cli, extract_score, estimate_cost, _estimate_tokens,
+    )
+    from stepplan import WorktreeSet
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+EVAL_REPORT = STATE_DIR / "eval_report.json"
+DEFAULT_SAMPLES_PER_LABEL = 20
+DEFAULT_MIN_QUALITY = 0.9
+# Grader scores this many points apart count as full disagreement
+GRADE_TOLERANCE = 20
+
+
+# ============================================================================
+# CHECKS
+# ============================================================================
+
+@dataclass
+class Check:
+    """Outcome of scoring one output: schema validity, agreement in [0, 1], score delta."""
+    valid: bool
+    agreement: Optional[float] = None
+    delta: Optional[float] = None
+
+    @property
+    def quality(self) -> float:
+        if not self.valid:
+            return 0.0
+        return 1.0 if self.agreement is None else self.agreement
+
+
+def _json(text: str, pattern: str):
+    # Same extraction the call sites use, so validity matches production parsing
+    try:
+        match = re.search(pattern, text or "")
+        return json.loads(match.group()) if match else None
+    except ValueError:
+        return None
+
+
+def _words(items) -> set[str]:
+    return {w for item in items for w in re.findall(r"[a-z0-9]+", str(item).lower()) if len(w) > 2}
+
+
+def _jaccard(a: set, b: set) -> float:
+    return len(a & b) / len(a | b) if a | b else 1.0
+
+
+def check_questions(output: str, reference: str) -> Check:
+    data = _json(output, r'\[[\s\S]*\]')
+    if not isinstance(data, list) or not all(isinstance(q, dict) and q.get("question") for q in data):
+        return Check(False)
+    ref = _json(reference, r'\[[\s\S]*\]')
+    if not isinstance(ref, list):
+        return Check(True)
+    cats = lambda qs: {q.get("category", "general") for q in qs if isinstance(q, dict)}
+    return Check(True, _jaccard(cats(data), cats(ref)))
+
+
+def check_spec(output: str, reference: str) -> Check:
+    data = _json(output, r'\{[\s\S]*\}')
+    if not isinstance(data, dict) or not data.get("title") or not isinstance(data.get("requirements"), list):
+        return Check(False)
+    ref = _json(reference, r'\{[\s\S]*\}')
+    if not isinstance(ref, dict):
+        return Check(True)
+    terms = lambda d: _words((d.get("requirements") or []) + (d.get("acceptance_criteria") or []))
+    return Check(True, _jaccard(terms(data), terms(ref)))
+
+
+def check_tasks(output: str, reference: str) -> Check:
+    data = _json(output, r'\[[\s\S]*\]')
+    if not isinstance(data, list) or not data or not all(isinstance(t, dict) and t.get("name") for t in data):
+        return Check(False)
+    ref = _json(reference, r'\[[\s\S]*\]')
+    if not isinstance(ref, list):
+        return Check(True)
+    names = lambda ts: _words(t.get("name", "") for t in ts if isinstance(t, dict))
+    return Check(True, _jaccard(names(data), names(ref)), delta=len(data) - len(ref))
+
+
+def check_review(output: str, reference: str) -> Check:
+    # Decision: were any deviations reported?
+    data = _json(output, r'\[[\s\S]*?\]')
+    if not isinstance(data, list):
+        return Check(False)
+    ref = _json(reference, r'\[[\s\S]*?\]')
+    if not isinstance(ref, list):
+        return Check(True)
+    return Check(True, float(bool(data) == bool(ref)), delta=len(data) - len(ref))
+
+
+def _flag_check(key: str) -> Callable[[str, str], Check]:
+    def check(output: str, reference: str) -> Check:
+        data = _json(output, r'\{[\s\S]*\}')
+        if not isinstance(data, dict) or key not in data:
+            return Check(False)
+        ref = _json(reference, r'\{[\s\S]*\}')
+        if not isinstance(ref, dict) or key not in ref:
+            return Check(True)
+        return Check(True, float(bool(data[key]) == bool(ref[key])))
+    return check
+
+
+def check_grade(output: str, reference: str) -> Check:
+    score = extract_score(output)
+    if not score:
+        return Check(False)
+    ref = extract_score(reference)
+    if not ref:
+        return Check(True)
+    delta = score - ref
+    return Check(True, max(0.0, 1 - abs(delta) / GRADE_TOLERANCE), delta=delta)
+
+
+def check_text(output: str, reference: str) -> Check:
+    return Check(bool(output.strip()))
+
+
+# Longest matching prefix wins
+CHECKS: dict[str, Callable[[str, str], Check]] = {
+    "tracer:clarify:questions": check_questions,
+    "tracer:clarify:spec": check_spec,
+    "tracer:ticket:tasks": check_tasks,
+    "tracer:execute:review": check_review,
+    "tracer:execute:monitor": _flag_check("drift"),
+    "tracer:execute:verify": _flag_check("all_met"),
+    "rpi:grade": check_grade,
+}
+
+
+def check_for(label: str) -> Callable[[str, str], Check]:
+    matches = [prefix for prefix in CHECKS if label.startswith(prefix)]
+    return CHECKS[max(matches, key=len)] if matches else check_text
+
+
+# ============================================================================
+# CORPUS
+# ============================================================================
+
+def load_corpus(labels: Optional[list[str]] = None) -> dict[str, list[dict]]:
+    """Recorded samples by label; re-recorded prompts keep their latest reference."""
+    samples: dict[str, dict] = {}
+    if EVAL_CORPUS.exists():
+        for line in EVAL_CORPUS.read_text().splitlines():
+            try:
+                sample = json.loads(line)
+            except ValueError:
+                continue
+            if labels and not any(sample.get("label", "").startswith(l) for l in labels):
+                continue
+            samples[sample["id"]] = sample
+    by_label: dict[str, list[dict]] = {}
+    for sample in samples.values():
+        by_label.setdefault(sample["label"], []).append(sample)
+    return by_label
+
+
+def print_corpus(labels: Optional[list[str]] = None):
+    corpus = load_corpus(labels)
+    if not corpus:
+        print(f"  {Colors.GRAY}No recorded samples (set ORCHESTRATOR_EVAL_RECORD=1){Colors.RESET}")
+        return
+    print(f"\n  {'label':<32} {'samples':>7} {'models':<28} {'mean in':>8} {'mean sec':>9}")
+    for label in sorted(corpus):
+        rows = corpus[label]
+        models = sorted({f"{s['cli']}:{s.get('model') or '-'}" for s in rows})
+        print(f"  {label:<32} {len(rows):>7} {', '.join(models)[:28]:<28} "
+              f"{statistics.mean(s['in_tokens'] for s in rows):>8.0f} "
+              f"{statistics.mean(s['elapsed_sec'] for s in rows):>8.1f}s")
+    print()
+
+
+# ============================================================================
+# REPLAY
+# ============================================================================
+
+def parse_candidate(spec: str) -> tuple[str, Optional[str]]:
+    """"copilot:gpt-5.1-codex-mini" -> ("copilot", "gpt-5.1-codex-mini"); "stub" -> ("stub", None)."""
+    cli, _, model = spec.partition(":")
+    if cli not in CLI_CONFIGS:
+        raise ValueError(f"unknown CLI '{cli}' in candidate '{spec}'")
+    if model and "model_flag" not in CLI_CONFIGS[cli]:
+        raise ValueError(f"CLI '{cli}' has no model_flag; cannot select model '{model}'")
+    return cli, model or None
+
+
+def _replay(sample: dict, cli: str, model: Optional[str], timeout: int, workspace) -> dict:
+    started = datetime.now()
+    output, code = run_cli(cli, sample["prompt"], timeout=timeout, workspace=workspace,
+                           show_output=False, usage_label=f"eval:{sample['label']}", model=model)
+    elapsed = (datetime.now() - started).total_seconds()
+    check = check_for(sample["label"])(output, sample["output"]) if code == 0 else Check(False)
+    out_tokens = _estimate_tokens(output)
+    return {
+        "id": sample["id"],
+        "code": code,
+        "valid": check.valid,
+        "agreement": check.agreement,
+        "delta": check.delta,
+        "quality": check.quality,
+        "elapsed_sec": elapsed,
+        "cost_usd": estimate_cost(model, sample["in_tokens"], out_tokens),
+    }
+
+
+def _summarize(name: str, results: list[dict]) -> dict:
+    agreements = [r["agreement"] for r in results if r["agreement"] is not None]
+    deltas = [r["delta"] for r in results if r["delta"] is not None]
+    return {
+        "candidate": name,
+        "samples": len(results),
+        "valid": sum(r["valid"] for r in results) / len(results),
+        "agreement": statistics.mean(agreements) if agreements else None,
+        "mean_delta": statistics.mean(deltas) if deltas else None,
+        "quality": statistics.mean(r["quality"] for r in results),
+        "latency_p50": statistics.median(r["elapsed_sec"] for r in results),
+        "cost_usd": statistics.mean(r["cost_usd"] for r in results),
+    }
+
+
+def _reference_row(samples: list[dict]) -> dict:
+    models = sorted({f"{s['cli']}:{s.get('model') or '-'}" for s in samples})
+    valid = statistics.mean(check_for(s["label"])(s["output"], s["output"]).valid for s in samples)
+    return {
+        "candidate": f"recorded ({', '.join(models)})",
+        "samples": len(samples),
+        "valid": valid,
+        "agreement": 1.0,
+        "mean_delta": None,
+        "quality": valid,
+        "latency_p50": statistics.median(s["elapsed_sec"] for s in samples),
+        "cost_usd": statistics.mean(estimate_cost(s.get("model"), s["in_tokens"], s["out_tokens"])
+                                    for s in samples),
+    }
+
+
+def mark_pareto(rows: list[dict]):
+    """Flag rows not dominated on (quality up, cost down, latency down)."""
+    for row in rows:
+        row["pareto"] = not any(
+            other["quality"] >= row["quality"] and other["cost_usd"] <= row["cost_usd"]
+            and other["latency_p50"] <= row["latency_p50"]
+            and (other["quality"], -other["cost_usd"], -other["latency_p50"])
+            != (row["quality"], -row["cost_usd"], -row["latency_p50"])
+            for other in rows if other is not row)
+
+
+class ReplaySandbox:
+    """
+    Working directories for replays. Recorded prompts write files ("Save to:
+    plans/…") and run tests with write-capable agents, so by default each
+    label × candidate replays in a fresh copy of the workspace:
+
+    - copy:  git worktree of a snapshot (tracked + untracked, minus state/),
+             or a plain directory copy outside git
+    - empty: an empty temporary directory
+    - live:  the workspace itself (opt-in; replays overwrite real artifacts)
+    """
+
+    def __init__(self, mode: str = "copy"):
+        self.mode = mode
+        self.temp = tempfile.TemporaryDirectory(prefix="eval-") if mode != "live" else None
+        self.trees = WorktreeSet(WORKSPACE) if mode == "copy" else None
+        self.base = self.trees.snapshot(self.trees.root, "HEAD") if self.trees and self.trees.available else None
+        self.worktrees: list[Path] = []
+
+    def open(self, name: str) -> Path:
+        if self.mode == "live":
+            return WORKSPACE
+        path = Path(self.temp.name) / name
+        if self.mode == "empty":
+            path.mkdir(parents=True)
+            return path
+        if self.base:
+            tree = self.trees.add(f"eval-{os.getpid()}-{name}", self.base)
+            if tree is not None:
+                self.worktrees.append(tree)
+                return tree / self.trees.prefix
+        # Only the workspace's own state/ stays behind; same-named dirs deeper down are copied
+        shutil.copytree(WORKSPACE, path, symlinks=True,
+                        ignore=lambda d, names: [STATE_DIR.name] if Path(d) == WORKSPACE else [])
+        return path
+
+    def close(self):
+        for tree in self.worktrees:
+            self.trees.remove(tree)
+        if self.worktrees:
+            self.trees.prune()
+        if self.temp:
+            self.temp.cleanup()
+
+
+def evaluate(candidates: list[str], labels: Optional[list[str]] = None,
+             samples_per_label: int = DEFAULT_SAMPLES_PER_LABEL, parallel: int = 2,
+             timeout: int = 300, workspace_mode: str = "copy", seed: int = 0) -> dict[str, list[dict]]:
+    """Replay the corpus against each candidate; returns summary rows per label."""
+    parsed = [(spec, *parse_candidate(spec)) for spec in candidates]
+    corpus = load_corpus(labels)
+    # Replays must hit the model, and must not seed the production cache or the corpus;
+    # both settings are restored afterwards
+    saved_env = {name: os.environ.get(name) for name in ("ORCHESTRATOR_CACHE", "ORCHESTRATOR_EVAL_RECORD")}
+    os.environ["ORCHESTRATOR_CACHE"] = "0"
+    os.environ.pop("ORCHESTRATOR_EVAL_RECORD", None)
+
+    sandbox = ReplaySandbox(workspace_mode)
+    report: dict[str, list[dict]] = {}
+    try:
+        for label in sorted(corpus):
+            samples = corpus[label]
+            if len(samples) > samples_per_label:
+                samples = random.Random(seed).sample(samples, samples_per_label)
+            rows = [_reference_row(samples)]
+            for name, cli, model in parsed:
+                print(f"  {Colors.GRAY}[eval]{Colors.RESET} {label} × {name} ({len(samples)} samples)")
+                workspace = sandbox.open(f"{len(report)}-{len(rows)}")
+                with ThreadPoolExecutor(max_workers=max(1, parallel)) as pool:
+                    results = list(pool.map(lambda s: _replay(s, cli, model, timeout, workspace), samples))
+                rows.append(_summarize(name, results))
+            mark_pareto(rows)
+            report[label] = rows
+    finally:
+        sandbox.close()
+        for name, value in saved_env.items():
+            if value is None:
+                os.environ.pop(name, None)
+            else:
+                os.environ[name] = value
+    return report
+
+
+def print_report(report: dict[str, list[dict]], min_quality: float = DEFAULT_MIN_QUALITY):
+    print()
+    print(f"{Colors.CYAN}═══ Model Evaluation ═══{Colors.RESET}")
+    for label, rows in report.items():
+        print(f"\n  {Colors.BOLD}{label}{Colors.RESET}")
+        print(f"    {'candidate':<36} {'n':>4} {'valid':>6} {'agree':>6} {'Δ':>6} "
+              f"{'quality':>7} {'p50':>7} {'cost':>9}")
+        for row in sorted(rows, key=lambda r: (-r["quality"], r["cost_usd"])):
+            agree = f"{row['agreement']:.0%}" if row["agreement"] is not None else "—"
+            delta = f"{row['mean_delta']:+.1f}" if row["mean_delta"] is not None else "—"
+            mark = f"{Colors.GREEN}★{Colors.RESET}" if row["pareto"] else " "
+            print(f"  {mark} {row['candidate'][:36]:<36} {row['samples']:>4} {row['valid']:>6.0%} "
+                  f"{agree:>6} {delta:>6} {row['quality']:>7.2f} {row['latency_p50']:>6.1f}s "
+                  f"${row['cost_usd']:>8.4f}")
+        eligible = [r for r in rows if r["pareto"] and r["quality"] >= min_quality]
+        if eligible:
+            pick = min(eligible, key=lambda r: (r["cost_usd"], r["latency_p50"]))
+            print(f"    {Colors.GRAY}cheapest on the front with quality ≥ {min_quality:.2f}: "
+                  f"{pick['candidate']}{Colors.RESET}")
+    print(f"\n  {Colors.GRAY}★ = Pareto front (quality, cost, p50 latency); report: {EVAL_REPORT}{Colors.RESET}\n")
+
+
+# ============================================================================
+# CLI
+# ============================================================================
+
+def run_eval(args):
+    labels = [l.strip() for l in (args.label or "").split(",") if l.strip()] or None
+    if args.action == "corpus":
+        print_corpus(labels)
+        return
+    if not args.models:
+        print(f"{Colors.RED}--models is required, e.g. --models copilot:gpt-5.1-codex-mini,stub{Colors.RESET}")
+        return
+    if not load_corpus(labels):
+        print(f"{Colors.YELLOW}No recorded samples in {EVAL_CORPUS} (set ORCHESTRATOR_EVAL_RECORD=1){Colors.RESET}")
+        return
+    candidates = [m.strip() for m in args.models.split(",") if m.strip()]
+    try:
+        report = evaluate(candidates, labels, args.samples, args.parallel, args.timeout,
+                          "empty" if args.scratch else args.workspace, args.seed)
+    except ValueError as e:
+        print(f"{Colors.RED}{e}{Colors.RESET}")
+        return
+
+    EVAL_REPORT.parent.mkdir(parents=True, exist_ok=True)
+    EVAL_REPORT.write_text(json.dumps({"ts": datetime.now().isoformat(), "labels": report}, indent=2))
+    if args.json:
+        print(json.dumps(report, indent=2))
+    else:
+        print_report(report, args.min_quality)
+
+
+def add_arguments(parser):
+    parser.add_argument("action", choices=["corpus", "run"], help="List the recorded corpus or replay it")
+    parser.add_argument("--models", help="Candidates as cli[:model], comma-separated")
+    parser.add_argument("--label", help="Label prefixes to include (comma-separated)")
+    parser.add_argument("--samples", type=int, default=DEFAULT_SAMPLES_PER_LABEL, help="Samples per label")
+    parser.add_argument("--parallel", type=int, default=2, help="Concurrent replays per candidate")
+    parser.add_argument("--timeout", type=int, default=300)
+    parser.add_argument("--min-quality", type=float, default=DEFAULT_MIN_QUALITY,
+                        help="Quality bar for the routing suggestion")
+    parser.add_argument("--workspace", choices=["copy", "empty", "live"], default="copy",
+                        help="Replay in a throwaway copy of the workspace (default), an empty "
+                             "directory, or the live workspace (replays may overwrite its files)")
+    parser.add_argument("--scratch", action="store_true", help="Same as --workspace empty")
+    parser.add_argument("--seed", type=int, default=0)
+    parser.add_argument("--json", action="store_true")
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Offline model evaluation on recorded prompts")
+    add_arguments(parser)
+    run_eval(parser.parse_args())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+"""
+Fair-Share Scheduling
+
+Weighted fair queuing of orchestrator tasks across tenants:
+- Tenants are tag tuples over configurable dimensions (workspace, story,
+  ticket, user)
+- Usage accounted in tokens and agent-seconds in a persistent ledger,
+  merged under a file lock so concurrent runs add up instead of overwriting
+- Per-tenant weights, concurrency limits and usage caps per window
+"""
+from __future__ import annotations
+
+import os
+import json
+import time
+import getpass
+from pathlib import Path
+from contextlib import contextmanager
+from typing import Optional
+
+try:
+    import fcntl
+except ImportError:  # Windows: charges are still merged, just without the lock
+    fcntl = None
+
+try:
+    from .utils import Colors, WORKSPACE, STATE_DIR
+except ImportError:
+    from utils import Colors, WORKSPACE, STATE_DIR
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+FAIRSHARE_CONFIG = STATE_DIR / "fairshare.json"
+FAIRSHARE_LEDGER = STATE_DIR / "fairshare_ledger.json"
+
+DEFAULT_DIMENSIONS = ("user",)
+DEFAULT_METRIC = "agent_seconds"
+DEFAULT_TASK_SECONDS = 60.0
+DEFAULT_WINDOW_HOURS = 24.0
+
+
+def fairshare_enabled() -> bool:
+    return os.getenv("ORCHESTRATOR_FAIRSHARE") == "1"
+
+
+def default_tags() -> dict[str, str]:
+    try:
+        user = getpass.getuser()
+    except Exception:
+        user = "unknown"
+    return {"workspace": WORKSPACE.name, "user": os.getenv("ORCHESTRATOR_USER") or user}
+
+
+def parse_tags(raw: Optional[str]) -> dict[str, str]:
+    """Parse "user=alice,story=US-3" into a tag dict."""
+    tags = {}
+    for item in (raw or "").split(","):
+        if "=" in item:
+            key, val = item.split("=", 1)
+            tags[key.strip()] = val.strip()
+    return tags
+
+
+class FairShareConfig:
+    """
+    state/fairshare.json, e.g.:
+
+        {"dimensions": ["user", "story"],
+         "metric": "agent_seconds",
+         "window_hours": 24,
+         "weights": {"user=alice": 2, "story=US-9": 0.5},
+         "caps": {"user=bob": {"tokens": 2000000, "agent_seconds": 7200, "concurrent": 2}}}
+
+    Weights multiply across the dimensions of a tenant; caps apply to each
+    "dim=value" across all tenants sharing it.
+    """
+
+    def __init__(self, path: Path = FAIRSHARE_CONFIG):
+        data = {}
+        if path.exists():
+            try:
+                data = json.loads(path.read_text())
+            except ValueError:
+                print(f"  {Colors.YELLOW}[fairshare]{Colors.RESET} ignoring malformed {path.name}")
+        dims = os.getenv("ORCHESTRATOR_FAIRSHARE_KEYS")
+        self.dimensions = tuple(d.strip() for d in dims.split(",") if d.strip()) if dims else \
+            tuple(data.get("dimensions", DEFAULT_DIMENSIONS))
+        self.metric = data.get("metric", DEFAULT_METRIC)
+        self.window_sec = float(data.get("window_hours", DEFAULT_WINDOW_HOURS)) * 3600
+        self.weights: dict[str, float] = data.get("weights", {})
+        self.caps: dict[str, dict] = data.get("caps", {})
+
+    def tenant(self, tags: dict[str, str]) -> tuple[str, ...]:
+        return tuple(f"{d}={tags.get(d, '-')}" for d in self.dimensions)
+
+    def weight(self, tenant: tuple[str, ...]) -> float:
+        w = 1.0
+        for part in tenant:
+            w *= float(self.weights.get(part, 1.0))
+        return max(w, 1e-6)
+
+
+# ============================================================================
+# LEDGER
+# ============================================================================
+
+class Ledger:
+    """Per "dim=value" and per tenant usage totals within the current window."""
+
+    def __init__(self, window_sec: float, path: Path = FAIRSHARE_LEDGER):
+        self.path = path
+        self.lock_path = path.with_suffix(".lock")
+        self.window_sec = window_sec
+        self.data = self._read()
+
+    def _read(self) -> dict:
+        data = {"since": time.time(), "entries": {}}
+        if self.path.exists():
+            try:
+                data = json.loads(self.path.read_text())
+            except (OSError, ValueError):
+                pass
+        if time.time() - data.get("since", 0) > self.window_sec:
+            data = {"since": time.time(), "entries": {}}
+        return data
+
+    @contextmanager
+    def _locked(self):
+        self.lock_path.parent.mkdir(parents=True, exist_ok=True)
+        with open(self.lock_path, "a") as handle:
+            if fcntl:
+                fcntl.flock(handle, fcntl.LOCK_EX)
+            try:
+                yield
+            finally:
+                if fcntl:
+                    fcntl.flock(handle, fcntl.LOCK_UN)
+
+    def entry(self, key: str) -> dict:
+        return self.data["entries"].setdefault(key, {"tokens": 0, "agent_seconds": 0.0, "tasks": 0})
+
+    def charge(self, tenant: tuple[str, ...], tokens: int, seconds: float):
+        # Other runs may have charged since we last looked: re-read under the lock,
+        # add this charge and write back, which also refreshes our view of their usage
+        try:
+            with self._locked():
+                self.data = self._read()
+                self._add(tenant, tokens, seconds)
+                self.save()
+        except OSError as e:
+            self._add(tenant, tokens, seconds)
+            print(f"  {Colors.YELLOW}[fairshare]{Colors.RESET} ledger lock failed: {e}")
+
+    def _add(self, tenant: tuple[str, ...], tokens: int, seconds: float):
+        # "*" totals, the full tenant, and each of its dim=value parts
+        for key in {"*", ",".join(tenant), *tenant}:
+            e = self.entry(key)
+            e["tokens"] += tokens
+            e["agent_seconds"] += seconds
+            e["tasks"] += 1
+
+    def mean_per_task(self, metric: str) -> float:
+        total = self.data["entries"].get("*")
+        if total and total["tasks"]:
+            return total[metric] / total["tasks"]
+        return DEFAULT_TASK_SECONDS if metric == "agent_seconds" else 1.0
+
+    def save(self):
+        try:
+            self.path.parent.mkdir(parents=True, exist_ok=True)
+            tmp = self.path.with_suffix(f".{os.getpid()}.tmp")
+            tmp.write_text(json.dumps(self.data, indent=2))
+            os.replace(tmp, self.path)
+        except OSError as e:
+            print(f"  {Colors.YELLOW}[fairshare]{Colors.RESET} ledger write failed: {e}")
+
+
+# ============================================================================
+# SCHEDULER
+# ============================================================================
+
+class FairShareScheduler:
+    """Picks the next task from the tenant with the lowest weighted usage."""
+
+    def __init__(self, config: Optional[FairShareConfig] = None, ledger: Optional[Ledger] = None):
+        self.config = config or FairShareConfig()
+        self.ledger = ledger or Ledger(self.config.window_sec)
+        self.running: dict[int, tuple[tuple[str, ...], float]] = {}  # id(task) -> (tenant, start)
+
+    def tenant_of(self, task) -> tuple[str, ...]:
+        return self.config.tenant({**default_tags(), **(getattr(task, "tags", None) or {})})
+
+    def _usage(self, key: str) -> float:
+        e = self.ledger.data["entries"].get(key, {})
+        return float(e.get(self.config.metric, 0.0))
+
+    def cap_reason(self, tenant: tuple[str, ...]) -> Optional[str]:
+        for part in tenant:
+            cap = self.config.caps.get(part)
+            if not cap:
+                continue
+            e = self.ledger.data["entries"].get(part, {})
+            for metric in ("tokens", "agent_seconds"):
+                if metric in cap and e.get(metric, 0) >= cap[metric]:
+                    return f"{part} reached its {metric} cap ({cap[metric]})"
+        return None
+
+    def _concurrency_ok(self, tenant: tuple[str, ...]) -> bool:
+        for part in tenant:
+            limit = (self.config.caps.get(part) or {}).get("concurrent")
+            if limit is not None:
+                active = sum(1 for t, _ in self.running.values() if part in t)
+                if active >= limit:
+                    return False
+        return True
+
+    def virtual_time(self, tenant: tuple[str, ...], now: float) -> float:
+        """Weighted usage including work already in flight for the tenant."""
+        per_task = self.ledger.mean_per_task(self.config.metric)
+        seconds = self.config.metric == "agent_seconds"
+        in_flight = sum(max(per_task, now - start) if seconds else per_task
+                        for t, start in self.running.values() if t == tenant)
+        return (self._usage(",".join(tenant)) + in_flight) / self.config.weight(tenant)
+
+    def pick(self, pending: list) -> Optional[object]:
+        """Next task to start, or None if every pending tenant is capped or at its limit."""
+        now = time.time()
+        best, best_key = None, None
+        for order, task in enumerate(pending):
+            tenant = self.tenant_of(task)
+            if self.cap_reason(tenant) or not self._concurrency_ok(tenant):
+                continue
+            key = (self.virtual_time(tenant, now), order)
+            if best_key is None or key < best_key:
+                best, best_key = task, key
+        return best
+
+    def started(self, task):
+        self.running[id(task)] = (self.tenant_of(task), time.time())
+
+    def finished(self, task, tokens: int):
+        tenant, start = self.running.pop(id(task), (self.tenant_of(task), time.time()))
+        self.ledger.charge(tenant, tokens, time.time() - start)
+
+    def print_ledger(self):
+        entries = self.ledger.data["entries"]
+        print(f"\n  {Colors.CYAN}Fair-share usage since "
+              f"{time.strftime('%Y-%m-%d %H:%M', time.localtime(self.ledger.data['since']))}:{Colors.RESET}")
+        for key in sorted(entries):
+            e = entries[key]
+            cap = self.config.caps.get(key, {})
+            cap_txt = ", ".join(f"{m}≤{v}" for m, v in cap.items())
+            print(f"    {key:<36} tasks={e['tasks']:<5} tokens≈{e['tokens']:<9} "
+                  f"agent-sec={e['agent_seconds']:<9.0f} {Colors.GRAY}{cap_txt}{Colors.RESET}")
+        print()
@@ -0,0 +1,311 @@
+#!/usr/bin/env python3
+"""
+Workspace Fingerprinting
+
+Persistent Merkle tree over the workspace for "has it changed, and where":
+- Incremental refresh: files are rehashed only when mtime/size/inode change
+- Git index stat data seeds blob digests without reading unchanged files
+- Whole-tree and per-subtree digests; subtree queries only rescan that subtree
+"""
+from __future__ import annotations
+
+import os
+import json
+import hashlib
+import threading
+import subprocess
+import time
+from pathlib import Path
+from typing import Optional
+
+try:
+    from .utils import WORKSPACE
+except ImportError:
+    from utils import WORKSPACE
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+# VCS metadata, bytecode and vendor trees, wherever they appear
+FINGERPRINT_SKIP_NAMES = {".git", "__pycache__", "node_modules", ".venv"}
+# Skipped only at the workspace root (the orchestrator's own state); a
+# project's src/state/ still counts
+FINGERPRINT_SKIP_PATHS = {"state"}
+INDEX_NAME = "fingerprint.json"
+# Top-level directories the orchestrator itself writes while recording progress
+ORCHESTRATOR_DIRS = ("state", "specs", "tickets")
+# Files modified this close to the previous scan may change again within the
+# same mtime tick, so their cached digest is not trusted ("racy git" rule)
+RACY_WINDOW_NS = 2_000_000_000
+
+
+def _blob_digest(path: Path) -> Optional[str]:
+    """Git-compatible blob id, so git index entries can seed the tree."""
+    try:
+        data = path.read_bytes()
+    except OSError:
+        return None
+    return hashlib.sha1(b"blob %d\0" % len(data) + data).hexdigest()
+
+
+def _git_index(workspace: Path) -> dict[str, tuple[int, int, int, str]]:
+    """path -> (mtime_ns, size, inode, blob sha) from `git ls-files --debug`."""
+    if not (workspace / ".git").exists():
+        return {}
+    try:
+        out = subprocess.run(["git", "ls-files", "-s", "--debug"], cwd=str(workspace),
+                             capture_output=True, text=True, timeout=30)
+    except Exception:
+        return {}
+    if out.returncode != 0:
+        return {}
+
+    index = {}
+    path, sha, mtime, ino = None, None, 0, 0
+    for line in out.stdout.splitlines():
+        if not line.startswith(" "):
+            meta, _, path = line.partition("\t")
+            parts = meta.split()
+            sha = parts[1] if len(parts) == 3 and not path.startswith('"') else None
+        elif sha and line.strip().startswith("mtime:"):
+            sec, _, nsec = line.split(":", 1)[1].strip().partition(":")
+            mtime = int(sec) * 1_000_000_000 + int(nsec or 0)
+        elif sha and "ino:" in line:
+            ino = int(line.split("ino:")[1].split()[0])
+        elif sha and line.strip().startswith("size:"):
+            size = int(line.split("size:")[1].split()[0])
+            index[path] = (mtime, size, ino, sha)
+    return index
+
+
+# ============================================================================
+# MERKLE TREE
+# ============================================================================
+
+class MerkleTree:
+    """Per-file blob digests with directory digests folded bottom-up."""
+
+    def __init__(self, workspace: Path = WORKSPACE, index_file: Optional[Path] = None):
+        self.workspace = Path(workspace).resolve()
+        self.index_file = index_file or self.workspace / "state" / INDEX_NAME
+        # rel path -> [mtime_ns, size, inode, digest]
+        self.files: dict[str, list] = {}
+        # dir rel path -> {child name: digest}; "" is the root
+        self.children: dict[str, dict[str, str]] = {"": {}}
+        self.dirs: dict[str, str] = {}
+        self.last_scan_ns = 0
+        self._git: Optional[dict] = None
+        self._lock = threading.RLock()
+        self._load()
+
+    # ------------------------------------------------------------------ state
+
+    def _load(self):
+        try:
+            data = json.loads(self.index_file.read_text())
+            self.files = data.get("files", {})
+            self.last_scan_ns = data.get("last_scan_ns", 0)
+        except (OSError, ValueError):
+            self.files = {}
+        for rel, entry in self.files.items():
+            self._set_file(rel, entry[3])
+        self._fold(set(self.children))
+
+    def _save(self):
+        try:
+            self.index_file.parent.mkdir(parents=True, exist_ok=True)
+            tmp = self.index_file.with_suffix(f".{os.getpid()}.tmp")
+            tmp.write_text(json.dumps({"last_scan_ns": self.last_scan_ns, "files": self.files}))
+            os.replace(tmp, self.index_file)
+        except OSError:
+            pass
+
+    # ------------------------------------------------------------------- scan
+
+    def _scan(self, subpath: str):
+        root = self.workspace / subpath if subpath else self.workspace
+        if root.is_file():
+            yield subpath, root.stat()
+            return
+        # Plain strings instead of Path objects: path parsing dominates large scans
+        stack = [(str(root), f"{subpath}/" if subpath else "")]
+        while stack:
+            current, rel_dir = stack.pop()
+            try:
+                entries = list(os.scandir(current))
+            except OSError:
+                continue
+            for entry in entries:
+                try:
+                    if entry.is_dir(follow_symlinks=False):
+                        rel = rel_dir + entry.name
+                        if entry.name not in FINGERPRINT_SKIP_NAMES and rel not in FINGERPRINT_SKIP_PATHS:
+                            stack.append((entry.path, f"{rel}/"))
+                    elif entry.is_file(follow_symlinks=False):
+                        yield rel_dir + entry.name, entry.stat(follow_symlinks=False)
+                except OSError:
+                    continue
+
+    def _seed(self, rel: str, key: tuple) -> Optional[str]:
+        if self._git is None:
+            self._git = _git_index(self.workspace)
+        hit = self._git.get(rel)
+        if hit and hit[0] == key[0] and hit[1] == key[1] and (not hit[2] or hit[2] == key[2]):
+            return hit[3]
+        return None
+
+    def refresh(self, subpath: str = "") -> list[str]:
+        """Rescan (part of) the workspace; returns paths whose content changed."""
+        subpath = subpath.strip("/")
+        prefix = f"{subpath}/" if subpath else ""
+        with self._lock:
+            started = time.time_ns()
+            racy_after = self.last_scan_ns - RACY_WINDOW_NS
+            seen = set()
+            changed = []
+            for rel, st in self._scan(subpath):
+                seen.add(rel)
+                key = (st.st_mtime_ns, st.st_size, st.st_ino)
+                old = self.files.get(rel)
+                if old and tuple(old[:3]) == key and st.st_mtime_ns < racy_after:
+                    continue
+                digest = (None if old else self._seed(rel, key)) or _blob_digest(self.workspace / rel)
+                if digest is None:
+                    continue
+                if not old or old[3] != digest:
+                    changed.append(rel)
+                self.files[rel] = [*key, digest]
+
+            removed = [rel for rel in self.files
+                       if (rel == subpath or rel.startswith(prefix)) and rel not in seen]
+            for rel in removed:
+                del self.files[rel]
+            changed.extend(removed)
+
+            dirty = set()
+            for rel in changed:
+                dirty.update(self._set_file(rel, self.files[rel][3] if rel in self.files else None))
+            self._fold(dirty)
+            if not subpath:
+                self.last_scan_ns = started
+            if changed or not subpath:
+                self._save()
+            return sorted(changed)
+
+    # ------------------------------------------------------------------- tree
+
+    def _set_file(self, rel: str, digest: Optional[str]) -> list[str]:
+        """Update a leaf in its parent's child map; returns the dirty ancestors."""
+        parent, _, name = rel.rpartition("/")
+        ancestors = [parent]
+        while ancestors[-1]:
+            ancestors.append(ancestors[-1].rpartition("/")[0])
+        for d in ancestors:
+            self.children.setdefault(d, {})
+        if digest is None:
+            self.children[parent].pop(name, None)
+        else:
+            self.children[parent][name] = digest
+        return ancestors
+
+    def _fold(self, dirty: set[str]):
+        """Recompute dirty directory digests deepest-first, propagating to parents."""
+        for d in sorted(dirty, key=lambda p: (p.count("/") + bool(p), p), reverse=True):
+            entries = self.children.get(d, {})
+            parent, _, name = d.rpartition("/")
+            if not entries and d:
+                self.children.pop(d, None)
+                self.dirs.pop(d, None)
+                self.children.get(parent, {}).pop(name, None)
+                continue
+            h = hashlib.sha1()
+            for child in sorted(entries):
+                h.update(f"{child}\0{entries[child]}\n".encode())
+            self.dirs[d] = h.hexdigest()
+            if d:
+                self.children.setdefault(parent, {})[name] = self.dirs[d]
+
+    # ---------------------------------------------------------------- queries
+
+    def digest(self, subpath: str = "", refresh: bool = True) -> str:
+        """Digest of the whole tree ("") or of one directory/file."""
+        subpath = subpath.strip("/")
+        with self._lock:
+            if refresh:
+                self.refresh(subpath)
+            if subpath in self.files:
+                return self.files[subpath][3]
+            return self.dirs.get(subpath, hashlib.sha1(b"").hexdigest())
+
+    def digest_excluding(self, names: tuple[str, ...], refresh: bool = True) -> str:
+        """Whole-tree digest leaving out the given top-level entries."""
+        with self._lock:
+            if refresh:
+                self.refresh()
+            entries = {k: v for k, v in self.children.get("", {}).items() if k not in names}
+            h = hashlib.sha1()
+            for child in sorted(entries):
+                h.update(f"{child}\0{entries[child]}\n".encode())
+            return h.hexdigest()
+
+    def subtree_digests(self, depth: int = 1) -> dict[str, str]:
+        """Directory digests down to `depth` levels (root = depth 0)."""
+        with self._lock:
+            return {d: h for d, h in self.dirs.items() if (d.count("/") + bool(d)) <= depth}
+
+
+_trees: dict[Path, MerkleTree] = {}
+_trees_lock = threading.Lock()
+
+
+def fingerprint_tree(workspace: Path = WORKSPACE) -> MerkleTree:
+    """Process-wide tree per workspace (loaded once, refreshed incrementally)."""
+    key = Path(workspace).resolve()
+    with _trees_lock:
+        if key not in _trees:
+            _trees[key] = MerkleTree(key)
+        return _trees[key]
+
+
+def workspace_fingerprint(workspace: Path = WORKSPACE, subpath: str = "") -> str:
+    """Short digest of the workspace (or a subtree) content."""
+    return fingerprint_tree(workspace).digest(subpath)[:16]
+
+
+def code_fingerprint(workspace: Path = WORKSPACE) -> str:
+    """
+    Short digest of the workspace without specs/, tickets/ and state/, so the
+    orchestrator saving a ticket or checkpoint does not count as a change.
+    """
+    return fingerprint_tree(workspace).digest_excluding(ORCHESTRATOR_DIRS)[:16]
+
+
+# ============================================================================
+# CLI
+# ============================================================================
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Workspace Merkle fingerprint")
+    parser.add_argument("path", nargs="?", default="", help="Subtree relative to the workspace")
+    parser.add_argument("--depth", type=int, default=0, help="Also print directory digests to this depth")
+    args = parser.parse_args()
+
+    tree = fingerprint_tree()
+    started = time.perf_counter()
+    changed = tree.refresh(args.path)
+    elapsed = time.perf_counter() - started
+    print(f"{tree.digest(args.path, refresh=False)}  {args.path or '.'}  "
+          f"({len(tree.files)} files, {len(changed)} changed, {elapsed * 1000:.1f}ms)")
+    for rel in changed[:20]:
+        print(f"  ~ {rel}")
+    for d, h in sorted(tree.subtree_digests(args.depth).items()):
+        if d:
+            print(f"  {h[:16]}  {d}/")
+
+
+if __name__ == "__main__":
+    main()
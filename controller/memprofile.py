@@ -0,0 +1,167 @@
+#!/usr/bin/env python3
+"""
+Memory Profiling
+
+tracemalloc snapshots at phase boundaries for the orchestrator process:
+- Top allocation-site diffs per phase under state/profiles/<run>/
+- Peak traced memory per phase, and the process RSS peak so far with how
+  much each phase raised it, in summary.json
+"""
+from __future__ import annotations
+
+import os
+import sys
+import json
+import atexit
+import linecache
+import threading
+import tracemalloc
+from datetime import datetime
+from typing import Optional
+
+try:
+    from .utils import Colors, STATE_DIR, PHASE_HOOKS
+except ImportError:
+    from utils import Colors, STATE_DIR, PHASE_HOOKS
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+PROFILES_DIR = STATE_DIR / "profiles"
+TOP_SITES = 25
+TRACE_FRAMES = 5
+
+
+def memprofile_enabled() -> bool:
+    return os.getenv("ORCHESTRATOR_MEMPROFILE") == "1"
+
+
+def _rss_kb() -> int:
+    try:
+        import resource
+        usage = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+        return usage // 1024 if sys.platform == "darwin" else usage
+    except Exception:
+        return 0
+
+
+# ============================================================================
+# PROFILER
+# ============================================================================
+
+class MemProfiler:
+    """Snapshots traced allocations whenever a new phase starts."""
+
+    def __init__(self, run_id: Optional[str] = None):
+        self.run_id = run_id or datetime.now().strftime("%Y%m%d-%H%M%S")
+        self.dir = PROFILES_DIR / self.run_id
+        self.phase = "startup"
+        self.index = 0
+        self.snapshot: Optional[tracemalloc.Snapshot] = None
+        self.phases: list[dict] = []
+        self.rss_peak_kb = 0
+        # Phase banners are printed from worker threads too
+        self.lock = threading.Lock()
+
+    def start(self):
+        self.dir.mkdir(parents=True, exist_ok=True)
+        tracemalloc.start(TRACE_FRAMES)
+        self.snapshot = self._take()
+        self.rss_peak_kb = _rss_kb()
+        PHASE_HOOKS.append(self.mark)
+        atexit.register(self.stop)
+        print(f"  {Colors.GRAY}[memprofile]{Colors.RESET} writing to {self.dir}")
+
+    def mark(self, next_phase: str):
+        """Close the current phase and start profiling the next one."""
+        with self.lock:
+            self._mark(next_phase)
+
+    def _mark(self, next_phase: str):
+        if not tracemalloc.is_tracing():
+            return
+        current, peak = tracemalloc.get_traced_memory()
+        snapshot = self._take()
+        self.index += 1
+        diff_file = self.dir / f"{self.index:02d}_{self._slug(self.phase)}.txt"
+        stats = snapshot.compare_to(self.snapshot, "traceback") if self.snapshot else []
+        self._write_diff(diff_file, stats)
+
+        # ru_maxrss is a high-water mark for the whole process, not this phase
+        rss_peak = _rss_kb()
+        self.phases.append({
+            "index": self.index,
+            "phase": self.phase,
+            "ended_at": datetime.now().isoformat(),
+            "current_kb": current // 1024,
+            "peak_kb": peak // 1024,
+            "rss_peak_so_far_kb": rss_peak,
+            "rss_peak_rise_kb": max(0, rss_peak - self.rss_peak_kb),
+            "growth_kb": sum(s.size_diff for s in stats) // 1024,
+            "diff_file": diff_file.name,
+        })
+        self.snapshot = snapshot
+        self.rss_peak_kb = rss_peak
+        self.phase = next_phase
+        if hasattr(tracemalloc, "reset_peak"):
+            tracemalloc.reset_peak()
+
+    def stop(self):
+        with self.lock:
+            if not tracemalloc.is_tracing():
+                return
+            self._mark("end")
+            tracemalloc.stop()
+        if self.mark in PHASE_HOOKS:
+            PHASE_HOOKS.remove(self.mark)
+        summary = {"run_id": self.run_id, "phases": self.phases}
+        (self.dir / "summary.json").write_text(json.dumps(summary, indent=2))
+        self.print_summary()
+
+    def print_summary(self):
+        print()
+        print(f"{Colors.CYAN}═══ Memory Profile ({self.run_id}) ═══{Colors.RESET}")
+        print(f"  {'phase':<20} {'peak':>10} {'current':>10} {'growth':>10} {'rss peak':>10} {'rise':>10}")
+        for p in self.phases:
+            print(f"  {p['phase'][:20]:<20} {p['peak_kb']:>8}KB {p['current_kb']:>8}KB "
+                  f"{p['growth_kb']:>+8}KB {p['rss_peak_so_far_kb']:>8}KB {p['rss_peak_rise_kb']:>+8}KB")
+        print(f"  {Colors.GRAY}rss peak: process high-water mark so far; rise: how much this phase raised it"
+              f"{Colors.RESET}")
+        print(f"  {Colors.GRAY}Diffs: {self.dir}{Colors.RESET}")
+        print()
+
+    @staticmethod
+    def _take() -> tracemalloc.Snapshot:
+        return tracemalloc.take_snapshot().filter_traces((
+            tracemalloc.Filter(False, tracemalloc.__file__),
+            tracemalloc.Filter(False, linecache.__file__),
+            tracemalloc.Filter(False, "<frozen importlib._bootstrap>"),
+        ))
+
+    @staticmethod
+    def _slug(phase: str) -> str:
+        return "".join(c if c.isalnum() else "_" for c in phase.lower())[:40]
+
+    @staticmethod
+    def _write_diff(path, stats):
+        lines = [f"Top {TOP_SITES} allocation sites by growth\n"]
+        for stat in stats[:TOP_SITES]:
+            lines.append(f"{stat.size_diff / 1024:+10.1f} KB  {stat.count_diff:+7d} blocks  "
+                         f"(total {stat.size / 1024:.1f} KB)")
+            for frame in stat.traceback.format():
+                lines.append(f"    {frame}")
+        path.write_text("\n".join(lines) + "\n")
+
+
+_profiler: Optional[MemProfiler] = None
+
+
+def start_profiling() -> MemProfiler:
+    """Start the process-wide profiler (idempotent)."""
+    global _profiler
+    if _profiler is None:
+        _profiler = MemProfiler()
+        _profiler.start()
+    return _profiler
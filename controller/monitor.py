@@ -0,0 +1,224 @@
+#!/usr/bin/env python3
+"""
+Online Deviation Monitor
+
+Watches a running implementer and aborts it early when it drifts:
+- Samples live output lines and workspace changes
+- Cheap lexical check against out-of-scope items and negative constraints
+- Confirms suspected drift with a cheap-model call before aborting
+- Sampling and confirmation run on a worker thread, so the implementer's
+  output keeps draining while the monitor thinks
+"""
+from __future__ import annotations
+
+import os
+import re
+import json
+import time
+import threading
+import subprocess
+from pathlib import Path
+from collections import deque
+from typing import Optional, Callable
+
+try:
+    from .utils import Colors, WORKSPACE, run_cli, compact_text, in_current_context
+except ImportError:
+    from utils import Colors, WORKSPACE, run_cli, compact_text, in_current_context
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+SAMPLE_EVERY_LINES = 25
+SAMPLE_MIN_INTERVAL = 15.0
+STRIKES_TO_CONFIRM = 2
+BUFFER_LINES = 200
+
+NEGATION_RE = re.compile(r"\b(do not|don't|must not|never|no|avoid|without)\b", re.IGNORECASE)
+WORD_RE = re.compile(r"[a-zA-Z][a-zA-Z0-9_./-]{3,}")
+STOPWORDS = {
+    "that", "this", "with", "without", "from", "into", "should", "must", "will",
+    "only", "other", "than", "then", "when", "where", "which", "while", "have",
+    "does", "done", "make", "made", "using", "used", "uses", "also", "there",
+    "their", "these", "those", "such", "some", "more", "less", "avoid", "never",
+    "changes", "change", "existing", "code", "file", "files", "support",
+}
+
+
+def monitor_enabled() -> bool:
+    return os.getenv("ORCHESTRATOR_MONITOR") != "0"
+
+
+def _keywords(text: str) -> set[str]:
+    return {w.lower().strip("./-") for w in WORD_RE.findall(text or "")} - STOPWORDS
+
+
+# ============================================================================
+# DRIFT MONITOR
+# ============================================================================
+
+class DriftMonitor:
+    """Samples an implementer's stream and flags confirmed drift."""
+
+    def __init__(self, cli: str, out_of_scope: list[str], constraints: list[str],
+                 task_name: str = "", workspace: Path = WORKSPACE):
+        self.cli = cli
+        self.task_name = task_name
+        self.workspace = workspace
+        self.items = self._build_items(out_of_scope, constraints)
+        self.buffer: deque[str] = deque(maxlen=BUFFER_LINES)
+        self.fresh_lines: list[str] = []
+        self.last_sample = time.time()
+        self.strikes: dict[str, int] = {}
+        self.cleared: set[str] = set()
+        self.baseline_paths = self._changed_paths()
+        self.deviation: Optional[dict] = None
+        self.worker: Optional[threading.Thread] = None
+        self.outcome: Optional[tuple[list[str], dict]] = None  # (confirmed suspects, verdict)
+
+    @staticmethod
+    def _build_items(out_of_scope: list[str], constraints: list[str]) -> list[dict]:
+        items = []
+        for text in out_of_scope or []:
+            keys = _keywords(text)
+            if keys:
+                items.append({"kind": "out_of_scope", "text": text, "keys": keys})
+        for text in constraints or []:
+            if not NEGATION_RE.search(text):
+                continue
+            keys = _keywords(NEGATION_RE.split(text, maxsplit=1)[-1])
+            if keys:
+                items.append({"kind": "constraint", "text": text, "keys": keys})
+        return items
+
+    @property
+    def active(self) -> bool:
+        return bool(self.items)
+
+    def wrap(self, on_line: Optional[Callable[[str], None]]) -> Callable[[str], None]:
+        """Wrap a display callback so every line is also sampled."""
+        def _on_line(line: str):
+            self.buffer.append(line)
+            self.fresh_lines.append(line)
+            if on_line:
+                on_line(line)
+        return _on_line
+
+    def check(self) -> Optional[str]:
+        """
+        Abort hook for run_cli, called from its read loop; returns a reason once
+        drift is confirmed. Never blocks: a due sample is handed to a worker
+        thread and its verdict is acted on at a later call.
+        """
+        if self.deviation or not self.items:
+            return None
+        if self.worker is not None:
+            if self.worker.is_alive():
+                return None
+            self.worker = None
+            return self._apply(self.outcome)
+
+        elapsed = time.time() - self.last_sample
+        if len(self.fresh_lines) < SAMPLE_EVERY_LINES and elapsed < SAMPLE_MIN_INTERVAL:
+            return None
+
+        sample = "\n".join(self.fresh_lines)
+        self.fresh_lines = []
+        self.last_sample = time.time()
+        self.outcome = None
+        self.worker = threading.Thread(target=in_current_context(self._sample), args=(sample,),
+                                       name="drift-monitor", daemon=True)
+        self.worker.start()
+        return None
+
+    def _sample(self, sample: str):
+        """Worker: lexical check of one sample, plus model confirmation when strikes add up."""
+        new_paths = sorted(self._changed_paths() - self.baseline_paths)
+        suspects = self._lexical_hits(sample, new_paths)
+        for item in self.items:
+            if item["text"] in suspects:
+                self.strikes[item["text"]] = self.strikes.get(item["text"], 0) + 1
+            else:
+                self.strikes.pop(item["text"], None)
+
+        confirmed = [t for t, n in self.strikes.items() if n >= STRIKES_TO_CONFIRM and t not in self.cleared]
+        if not confirmed:
+            return
+
+        print(f"  {Colors.YELLOW}[MONITOR]{Colors.RESET} possible drift: {', '.join(confirmed)[:120]}")
+        self.outcome = (confirmed, self._confirm(confirmed, new_paths))
+
+    def _apply(self, outcome: Optional[tuple[list[str], dict]]) -> Optional[str]:
+        if outcome is None:
+            return None
+        confirmed, verdict = outcome
+        if not verdict.get("drift"):
+            self.cleared.update(confirmed)
+            for text in confirmed:
+                self.strikes.pop(text, None)
+            return None
+
+        reason = verdict.get("description") or f"Drifted into: {'; '.join(confirmed)}"
+        self.deviation = {
+            "type": "OFF_TOPIC",
+            "description": reason,
+            "correction": verdict.get("correction") or f"Stay within the task; drop work on: {'; '.join(confirmed)}",
+            "source": "monitor",
+        }
+        return reason
+
+    def _lexical_hits(self, sample: str, paths: list[str]) -> set[str]:
+        haystack = _keywords(sample) | _keywords(" ".join(paths))
+        hits = set()
+        for item in self.items:
+            needed = max(1, (len(item["keys"]) + 1) // 2)
+            if len(item["keys"] & haystack) >= needed:
+                hits.add(item["text"])
+        return hits
+
+    def _changed_paths(self) -> set[str]:
+        try:
+            result = subprocess.run(
+                ["git", "status", "--porcelain", "-uall"],
+                cwd=str(self.workspace), capture_output=True, text=True, timeout=10,
+            )
+        except Exception:
+            return set()
+        if result.returncode != 0:
+            return set()
+        return {line[3:].strip() for line in result.stdout.splitlines() if len(line) > 3}
+
+    def _confirm(self, suspects: list[str], paths: list[str]) -> dict:
+        excerpt = compact_text("\n".join(self.buffer), 2500)
+        prompt = f'''
+An implementer is working on: {self.task_name}
+
+It must NOT do any of:
+{json.dumps(suspects)}
+
+Files changed so far: {json.dumps(paths[:30])}
+
+RECENT OUTPUT (excerpt):
+{excerpt}
+
+Is the implementer actually doing the forbidden work (not just mentioning it)?
+
+Output JSON:
+{{"drift": true/false, "description": "...", "correction": "..."}}
+'''
+        output, _ = run_cli(
+            self.cli,
+            prompt,
+            timeout=60,
+            show_output=False,
+            usage_label="tracer:execute:monitor",
+        )
+        try:
+            match = re.search(r'\{[\s\S]*\}', output)
+            if match:
+                return json.loads(match.group())
+        except Exception:
+            pass
+        return {"drift": False}
@@ -13,23 +13,42 @@ from __future__ import annotations
 import json
 import sys
 import signal
+import threading
 from pathlib import Path
+from contextlib import ExitStack
 from datetime import datetime
 from dataclasses import dataclass, field
 from typing import Optional, Callable
-from concurrent.futures import ThreadPoolExecutor, as_completed
+from concurrent.futures import ThreadPoolExecutor, as_completed, wait, FIRST_COMPLETED
 
 try:
     from .utils import (
-        Colors, WORKSPACE, AGENTS_DIR, COMMANDS_DIR,
-        run_cli, load_agent_prompt, print_header,
+        Colors, WORKSPACE, AGENTS_DIR, COMMANDS_DIR, CLI_CONFIGS,
+        run_cli, load_agent_prompt, print_header, emit_event, _estimate_tokens,
+        attribute, in_current_context,
     )
 except ImportError:
     from utils import (
-        Colors, WORKSPACE, AGENTS_DIR, COMMANDS_DIR,
-        run_cli, load_agent_prompt, print_header,
+        Colors, WORKSPACE, AGENTS_DIR, COMMANDS_DIR, CLI_CONFIGS,
+        run_cli, load_agent_prompt, print_header, emit_event, _estimate_tokens,
+        attribute, in_current_context,
     )
 
+try:
+    from .toolserver import ToolServer, SERVER_NAME, tool_server_enabled
+except ImportError:
+    from toolserver import ToolServer, SERVER_NAME, tool_server_enabled
+
+try:
+    from .blackboard import Blackboard, blackboard_enabled
+except ImportError:
+    from blackboard import Blackboard, blackboard_enabled
+
+try:
+    from .fairshare import FairShareScheduler, fairshare_enabled
+except ImportError:
+    from fairshare import FairShareScheduler, fairshare_enabled
+
 # ============================================================================
 # DATA STRUCTURES
 # ============================================================================
@@ -54,6 +73,8 @@ class Task:
     status: str = "pending"
     output: Optional[str] = None
     error: Optional[str] = None
+    # Tenant tags for fair-share scheduling (workspace, story, ticket, user)
+    tags: dict[str, str] = field(default_factory=dict)
 
 
 # ============================================================================
@@ -133,6 +154,14 @@ class Orchestrator:
     def __init__(self, cli: str = "claude"):
         self.cli = cli
         self.registry = AgentRegistry()
+        self.tool_server: Optional[ToolServer] = None
+        self.blackboard: Optional[Blackboard] = None
+        self._task_seq = 0
+
+    def create_task(self, name: str, agent: str, prompt: str, tags: Optional[dict] = None) -> Task:
+        """Create a task with a unique id."""
+        self._task_seq += 1
+        return Task(id=f"task-{self._task_seq}", name=name, agent=agent, prompt=prompt, tags=dict(tags or {}))
 
     def run_task(self, task: Task, timeout: int = 600) -> Task:
         """Run a single task."""
@@ -145,14 +174,34 @@ class Orchestrator:
         task.status = "running"
         self._print_task_start(task, agent)
 
-        output, code = run_cli(
-            self.cli,
-            task.prompt,
-            timeout=timeout,
-            usage_label=f"orch:{task.agent}",
-        )
+        prompt = task.prompt
+        # Only CLIs that take an MCP config (mcp_flag) can reach the shared tools
+        tools = self.tool_server is not None and "mcp_flag" in CLI_CONFIGS.get(self.cli, {})
+        if self.blackboard:
+            prompt += self.blackboard.prompt_section(tools_available=tools)
+        mcp_config = None
+        if tools:
+            mcp_config = self.tool_server.config_path
+            prompt += (f"\n\nFor read-only exploration prefer the `{SERVER_NAME}` tools "
+                       "(read_file, grep, glob); their results are shared with the other agents in this run.")
+
+        with ExitStack() as scope:
+            # Fair-share story/ticket tags double as cost attribution
+            for kind in ("story", "ticket"):
+                if task.tags.get(kind):
+                    scope.enter_context(attribute(kind, task.tags[kind]))
+            scope.enter_context(attribute("task", task.name))
+            output, code = run_cli(
+                self.cli,
+                prompt,
+                timeout=timeout,
+                usage_label=f"orch:{task.agent}",
+                mcp_config=mcp_config,
+            )
 
         task.output = output
+        if self.blackboard:
+            self.blackboard.ingest(task.agent, output)
         if code == 0:
             task.status = "completed"
             print(f"  {Colors.GREEN}✓ Completed{Colors.RESET}")
@@ -167,8 +216,40 @@ class Orchestrator:
         """Run tasks in parallel."""
         print(f"\n  {Colors.CYAN}Running {len(tasks)} tasks in parallel...{Colors.RESET}")
 
+        own_blackboard = blackboard_enabled() and not self.blackboard
+        own_tool_server = tool_server_enabled() and not self.tool_server
+        if own_blackboard:
+            self.blackboard = Blackboard()
+        if own_tool_server:
+            self.tool_server = ToolServer(blackboard=self.blackboard).start()
+
+        try:
+            return self._run_pool(tasks, max_workers, timeout)
+        finally:
+            if own_tool_server:
+                self.tool_server.stop()
+                self.tool_server = None
+            if own_blackboard:
+                print(f"  {Colors.GRAY}[blackboard]{Colors.RESET} {len(self.blackboard.findings)} finding(s) "
+                      f"in {self.blackboard.path.name}")
+                self.blackboard = None
+
+    def _run_pool(self, tasks: list[Task], max_workers: int, timeout: int) -> list[Task]:
+        if fairshare_enabled():
+            return self._run_fair_pool(tasks, max_workers, timeout)
+
+        queued = [len(tasks)]
+        lock = threading.Lock()
+
+        def pooled(task: Task) -> Task:
+            with lock:
+                queued[0] -= 1
+                emit_event("queue", pending=queued[0])
+            return self.run_task(task, timeout)
+
+        emit_event("queue", pending=len(tasks))
         with ThreadPoolExecutor(max_workers=max_workers) as executor:
-            futures = {executor.submit(self.run_task, t, timeout): t for t in tasks}
+            futures = {executor.submit(in_current_context(pooled), t): t for t in tasks}
             results = []
             for future in as_completed(futures):
                 try:
@@ -181,6 +262,46 @@ class Orchestrator:
 
         return results
 
+    def _run_fair_pool(self, tasks: list[Task], max_workers: int, timeout: int) -> list[Task]:
+        """Start tasks in weighted fair-share order as workers free up."""
+        scheduler = FairShareScheduler()
+        pending = list(tasks)
+        running = {}
+        results = []
+        with ThreadPoolExecutor(max_workers=max_workers) as executor:
+            while pending or running:
+                while pending and len(running) < max_workers:
+                    task = scheduler.pick(pending)
+                    if task is None:
+                        break
+                    pending.remove(task)
+                    scheduler.started(task)
+                    running[executor.submit(in_current_context(self.run_task), task, timeout)] = task
+                    emit_event("queue", pending=len(pending))
+
+                if not running:
+                    # Every remaining tenant is over its cap
+                    for task in pending:
+                        task.status = "skipped"
+                        task.error = scheduler.cap_reason(scheduler.tenant_of(task)) or "tenant cap reached"
+                        print(f"  {Colors.YELLOW}[fairshare]{Colors.RESET} skipped {task.name}: {task.error}")
+                    results.extend(pending)
+                    break
+
+                done, _ = wait(running, return_when=FIRST_COMPLETED)
+                for future in done:
+                    task = running.pop(future)
+                    try:
+                        future.result()
+                    except Exception as e:
+                        task.status = "failed"
+                        task.error = str(e)
+                    scheduler.finished(task, _estimate_tokens(task.prompt) + _estimate_tokens(task.output or ""))
+                    results.append(task)
+
+        scheduler.print_ledger()
+        return results
+
     def _print_task_start(self, task: Task, agent: AgentConfig):
         """Print task start."""
         color_map = {
@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+"""
+Risk-Based Review Policy
+
+Decides whether a Tracer iteration pays for a full deviation review:
+- Risk score from diff size, files touched, task type and deviation history
+- Full review above a threshold, random audit sampling below it
+- Escaped deviations (found after a skipped review) raise future risk
+"""
+from __future__ import annotations
+
+import os
+import json
+import random
+import subprocess
+from pathlib import Path
+from typing import Optional
+
+try:
+    from .utils import Colors, WORKSPACE, STATE_DIR
+except ImportError:
+    from utils import Colors, WORKSPACE, STATE_DIR
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+POLICY_FILE = STATE_DIR / "review_policy.json"
+
+DEFAULT_THRESHOLD = 0.35
+DEFAULT_AUDIT_RATE = 0.2
+TYPE_RISK = {"code": 0.25, "test": 0.05, "research": 0.0}
+LINES_SCALE = 400
+FILES_SCALE = 10
+
+
+def review_policy_enabled() -> bool:
+    return os.getenv("ORCHESTRATOR_REVIEW_POLICY") == "1"
+
+
+def _env_float(name: str, default: float) -> float:
+    try:
+        return float(os.getenv(name, default))
+    except ValueError:
+        return default
+
+
+# ============================================================================
+# DIFF STATS
+# ============================================================================
+
+def diff_snapshot(workspace: Path = WORKSPACE) -> dict[str, int]:
+    """Changed lines per path in the working tree (tracked diff + untracked files)."""
+    snapshot: dict[str, int] = {}
+    try:
+        numstat = subprocess.run(["git", "diff", "--numstat", "HEAD"], cwd=str(workspace),
+                                 capture_output=True, text=True, timeout=30)
+        for line in numstat.stdout.splitlines():
+            parts = line.split("\t")
+            if len(parts) == 3:
+                added = int(parts[0]) if parts[0].isdigit() else 1
+                removed = int(parts[1]) if parts[1].isdigit() else 0
+                snapshot[parts[2]] = added + removed
+        untracked = subprocess.run(["git", "ls-files", "--others", "--exclude-standard"],
+                                   cwd=str(workspace), capture_output=True, text=True, timeout=30)
+        for path in untracked.stdout.splitlines():
+            try:
+                snapshot[path] = sum(1 for _ in (workspace / path).open(errors="replace"))
+            except OSError:
+                snapshot[path] = 1
+    except Exception:
+        pass
+    return snapshot
+
+
+def diff_delta(before: dict[str, int], after: dict[str, int]) -> tuple[int, int]:
+    """Lines and files changed between two snapshots."""
+    files = [p for p in set(before) | set(after) if before.get(p) != after.get(p)]
+    lines = sum(abs(after.get(p, 0) - before.get(p, 0)) or 1 for p in files)
+    return lines, len(files)
+
+
+# ============================================================================
+# REVIEW POLICY
+# ============================================================================
+
+class ReviewPolicy:
+    """Risk model with per-task-type review history."""
+
+    def __init__(self, path: Path = POLICY_FILE, rng: Optional[random.Random] = None):
+        self.path = path
+        self.rng = rng or random.Random()
+        self.threshold = _env_float("ORCHESTRATOR_REVIEW_THRESHOLD", DEFAULT_THRESHOLD)
+        self.audit_rate = _env_float("ORCHESTRATOR_REVIEW_AUDIT", DEFAULT_AUDIT_RATE)
+        self.stats: dict[str, dict] = {}
+        if path.exists():
+            try:
+                self.stats = json.loads(path.read_text())
+            except Exception:
+                self.stats = {}
+
+    def _entry(self, task_type: str) -> dict:
+        return self.stats.setdefault(task_type, {"reviews": 0, "deviations": 0, "skipped": 0, "escapes": 0})
+
+    def deviation_rate(self, task_type: str) -> float:
+        e = self._entry(task_type)
+        return (e["deviations"] + e["escapes"] + 1) / (e["reviews"] + e["escapes"] + 2)
+
+    def score(self, task_type: str, lines: int, files: int) -> float:
+        risk = (
+            0.3 * min(1.0, lines / LINES_SCALE)
+            + 0.15 * min(1.0, files / FILES_SCALE)
+            + TYPE_RISK.get(task_type, 0.25)
+            + 0.3 * self.deviation_rate(task_type)
+        )
+        return min(1.0, risk)
+
+    def decide(self, task_type: str, lines: int, files: int) -> tuple[bool, str]:
+        risk = self.score(task_type, lines, files)
+        if risk >= self.threshold:
+            return True, f"risk {risk:.2f} ≥ {self.threshold:.2f}"
+        if self.rng.random() < self.audit_rate:
+            return True, f"audit sample (risk {risk:.2f})"
+        return False, f"risk {risk:.2f} < {self.threshold:.2f}"
+
+    def record_review(self, task_type: str, found_deviation: bool):
+        e = self._entry(task_type)
+        e["reviews"] += 1
+        if found_deviation:
+            e["deviations"] += 1
+        self._save()
+
+    def record_skip(self, task_type: str):
+        self._entry(task_type)["skipped"] += 1
+        self._save()
+
+    def record_escape(self, task_type: str):
+        """A deviation surfaced after this task type's review was skipped."""
+        self._entry(task_type)["escapes"] += 1
+        self._save()
+        print(f"  {Colors.YELLOW}[review]{Colors.RESET} escaped deviation recorded for '{task_type}' tasks")
+
+    def _save(self):
+        try:
+            self.path.parent.mkdir(parents=True, exist_ok=True)
+            self.path.write_text(json.dumps(self.stats, indent=2))
+        except Exception as e:
+            print(f"  {Colors.YELLOW}[review]{Colors.RESET} policy write failed: {e}")
@@ -6,15 +6,21 @@ Streamlined implementation using shared utilities.
 """
 from __future__ import annotations
 
+import os
+import re
 import sys
+import time
 import signal
+import threading
 from pathlib import Path
 from datetime import datetime
+from typing import Optional
 
 try:
     from .utils import (
         Colors, WORKSPACE, STATE_DIR,
         run_cli, extract_score, load_command_prompt, load_project_context,
+        note_prompt_section, compact_text, attribute, in_current_context,
         LoopState, load_state, save_state,
         get_current_story, print_header, print_phase, print_score,
     )
@@ -22,10 +28,24 @@ except ImportError:
     from utils import (
         Colors, WORKSPACE, STATE_DIR,
         run_cli, extract_score, load_command_prompt, load_project_context,
+        note_prompt_section, compact_text, attribute, in_current_context,
         LoopState, load_state, save_state,
         get_current_story, print_header, print_phase, print_score,
     )
 
+try:
+    from .scheduler import EtaModel, rpi_iterations_within, deadline_arg
+    from .stepplan import (
+        STEPS_INSTRUCTIONS, Step, parallel_steps_enabled, parse_steps, schedule_waves,
+        run_plan_steps, submission_summary,
+    )
+except ImportError:
+    from scheduler import EtaModel, rpi_iterations_within, deadline_arg
+    from stepplan import (
+        STEPS_INSTRUCTIONS, Step, parallel_steps_enabled, parse_steps, schedule_waves,
+        run_plan_steps, submission_summary,
+    )
+
 # ============================================================================
 # CONFIGURATION
 # ============================================================================
@@ -43,6 +63,14 @@ RUBRIC_FILE = WORKSPACE / "rubric.md"
 MAX_ITERATIONS = 10
 DEFAULT_TIMEOUT = 600
 
+# Streaming hand-off: the planner drafts once these research sections are final
+STREAM_SECTIONS = ("Summary", "Relevant Files", "Constraints")
+STREAM_POLL_SEC = 2.0
+
+
+def rpi_streaming_enabled() -> bool:
+    return os.getenv("ORCHESTRATOR_RPI_STREAM") == "1"
+
 
 # ============================================================================
 # PROMPT GENERATION
@@ -90,17 +118,34 @@ RESEARCHER PHASE - {story.get("id", "?")}
 
 ## Output
 Save to: research/{story.get("id", "?")}_research.md
-
+{_streaming_instructions() if rpi_streaming_enabled() else ""}
 BEGIN RESEARCH.
 '''
 
 
-def get_planner_prompt(story: dict) -> str:
-    """Generate planner prompt."""
+def _streaming_instructions() -> str:
+    first = ", ".join(f"`## {name}`" for name in STREAM_SECTIONS)
+    return f"""
+Write the file incrementally: a planner starts from your early sections while you
+continue. Begin with {first}, in that order. Append each `## ` section to the
+file as soon as it is final, and never rewrite a section once a later one follows it.
+"""
+
+
+def get_planner_prompt(story: dict, research: Optional[str] = None) -> str:
+    """Generate planner prompt (from the research file, or from early streamed sections)."""
     cmd_template = load_command_prompt("plan")
 
-    research_file = RESEARCH_DIR / f"{story.get('id', 'US-1')}_research.md"
-    research = load_project_context(research_file, max_chars=4000) or "No research found."
+    partial = ""
+    if research is None:
+        research_file = RESEARCH_DIR / f"{story.get('id', 'US-1')}_research.md"
+        research = load_project_context(research_file, max_chars=4000, section_name="research") or "No research found."
+    else:
+        research = compact_text(research, 4000)
+        note_prompt_section("research", research)
+        partial = ("\n> Research is still running. These sections are final; plan from them now. "
+                   "Later findings arrive in a short finishing pass.\n")
+
     rubric = load_project_context(RUBRIC_FILE, max_chars=2000)
 
     return f'''
@@ -109,11 +154,12 @@ PLANNER PHASE - {story.get("id", "?")}
 {cmd_template}
 
 ## Research Findings
+{partial}
 {research}
 
 ## Rubric
 {rubric[:2000]}
-
+{STEPS_INSTRUCTIONS if parallel_steps_enabled() else ""}
 ## Output
 Save to: plans/{story.get("id", "?")}_plan.md
 
@@ -121,12 +167,31 @@ CREATE THE PLAN.
 '''
 
 
+def get_plan_finish_prompt(story: dict, late_research: str) -> str:
+    """Fold research sections that finished after the plan draft into the plan."""
+    late_research = compact_text(late_research, 4000)
+    note_prompt_section("research", late_research)
+    return f'''
+PLANNER FINISHING PASS - {story.get("id", "?")}
+
+plans/{story.get("id", "?")}_plan.md was drafted from the first research sections.
+These sections of research/{story.get("id", "?")}_research.md were completed afterwards:
+
+{late_research}
+
+Update the plan file in place where these findings change it: add missing steps,
+fix steps they contradict. Leave everything else as it is. Be brief.
+
+UPDATE THE PLAN.
+'''
+
+
 def get_implementer_prompt(story: dict, version: int) -> str:
     """Generate implementer prompt."""
     cmd_template = load_command_prompt("implement")
 
     plan_file = PLANS_DIR / f"{story.get('id', 'US-1')}_plan.md"
-    plan = load_project_context(plan_file, max_chars=6000) or "No plan found."
+    plan = load_project_context(plan_file, max_chars=6000, section_name="plan") or "No plan found."
 
     return f'''
 IMPLEMENTER PHASE - {story.get("id", "?")} V{version}
@@ -143,13 +208,42 @@ IMPLEMENT NOW.
 '''
 
 
+def get_step_prompt(story: dict, version: int, step: Step) -> str:
+    """Implementer prompt for one step of a parallel plan."""
+    cmd_template = load_command_prompt("implement")
+
+    plan_file = PLANS_DIR / f"{story.get('id', 'US-1')}_plan.md"
+    plan = load_project_context(plan_file, max_chars=6000, section_name="plan") or "No plan found."
+    scope = ", ".join(step.files) or "(undeclared)"
+
+    return f'''
+IMPLEMENTER PHASE - {story.get("id", "?")} V{version} - STEP {step.id}
+
+{cmd_template}
+
+## The Plan
+{plan}
+
+## Your Step
+{step.id}: {step.title}
+Files you may modify: {scope}
+
+Other steps are being implemented at the same time in separate checkouts.
+Implement ONLY this step and stay inside its files. Do not create
+submission/V{version}/SUBMISSION.md; end with a short summary of what you changed.
+
+IMPLEMENT STEP {step.id} NOW.
+'''
+
+
 def get_grader_prompt(story: dict, version: int) -> str:
     """Generate grader prompt."""
     cmd_template = load_command_prompt("grade")
 
     plan_file = PLANS_DIR / f"{story.get('id', 'US-1')}_plan.md"
-    plan = load_project_context(plan_file, max_chars=4000)
-    rubric = load_project_context(RUBRIC_FILE, max_chars=2500)
+    plan = load_project_context(plan_file, max_chars=4000, section_name="plan")
+    # The grader scores against every rubric line
+    rubric = load_project_context(RUBRIC_FILE, max_chars=2500, critical=("*",))
 
     return f'''
 GRADER PHASE - {story.get("id", "?")} V{version}
@@ -201,6 +295,148 @@ def run_phase(cli: str, phase: str, prompt: str, output_file: Path,
         return output, code == 0
 
 
+# ============================================================================
+# STREAMING HAND-OFF
+# ============================================================================
+
+def split_sections(text: str) -> list[tuple[str, str]]:
+    """(heading, block) for each `## ` section; the preamble is dropped."""
+    return [(m.group(1).strip(), m.group(0).strip())
+            for m in re.finditer(r'^## +(.+?)[ \t]*$[\s\S]*?(?=^## |\Z)', text, re.M)]
+
+
+def _final_sections(path: Path, complete: bool) -> list[tuple[str, str]]:
+    # While research runs, the last section may still be growing
+    try:
+        sections = split_sections(path.read_text())
+    except OSError:
+        return []
+    return sections if complete else sections[:-1]
+
+
+def _stream_ready(sections: list[tuple[str, str]]) -> bool:
+    headings = [h.lower() for h, _ in sections]
+    return all(any(h.startswith(name.lower()) for h in headings) for name in STREAM_SECTIONS)
+
+
+def run_research_and_plan(cli: str, story: dict, prev_grading: str, timeout: int):
+    """Research with the planner drafting from finished sections, then a finishing pass."""
+    story_id = story.get("id", "US-1")
+    research_file = RESEARCH_DIR / f"{story_id}_research.md"
+    plan_file = PLANS_DIR / f"{story_id}_plan.md"
+    # Last iteration's research would look complete before the new run writes anything
+    research_file.unlink(missing_ok=True)
+
+    print_phase("RESEARCH", "streaming sections to the planner")
+    results: dict[str, tuple[str, int]] = {}
+
+    def research():
+        results["research"] = run_cli(cli, get_researcher_prompt(story, prev_grading),
+                                      timeout=timeout, usage_label="rpi:research")
+
+    def draft(early: str):
+        results["draft"] = run_cli(cli, get_planner_prompt(story, early), timeout=timeout,
+                                   show_output=False, usage_label="rpi:plan:draft")
+
+    started = time.time()
+    research_thread = threading.Thread(target=in_current_context(research), name="rpi-research", daemon=True)
+    research_thread.start()
+    draft_thread: Optional[threading.Thread] = None
+    drafted: dict[str, str] = {}
+    draft_started = 0.0
+    while research_thread.is_alive():
+        research_thread.join(STREAM_POLL_SEC)
+        if draft_thread is None and research_thread.is_alive():
+            sections = _final_sections(research_file, complete=False)
+            if _stream_ready(sections):
+                drafted = dict(sections)
+                draft_started = time.time()
+                print(f"  {Colors.CYAN}[stream]{Colors.RESET} planner drafting from "
+                      f"{len(sections)} section(s) after {draft_started - started:.0f}s")
+                draft_thread = threading.Thread(target=in_current_context(draft), args=("\n\n".join(drafted.values()),),
+                                                name="rpi-plan-draft", daemon=True)
+                draft_thread.start()
+    research_done = time.time()
+
+    output, code = results.get("research", ("", -1))
+    if research_file.exists():
+        print(f"  {Colors.GREEN}✓ {research_file.name} created{Colors.RESET}")
+    else:
+        print(f"  {Colors.YELLOW}⚠ Output file not created, saving raw output{Colors.RESET}")
+        research_file.parent.mkdir(parents=True, exist_ok=True)
+        research_file.write_text(output)
+
+    if draft_thread is None:
+        # The minimal section set never became final early: plain sequential hand-off
+        run_phase(cli, "PLAN", get_planner_prompt(story), plan_file, timeout)
+        return
+
+    def replan(reason: str):
+        # Whatever the failed pass left in the plan file must not pass for a plan
+        print(f"  {Colors.YELLOW}⚠ {reason}; planning again from the full research{Colors.RESET}")
+        if plan_file.exists() and plan_file.stat().st_mtime >= draft_started:
+            plan_file.unlink()
+        run_phase(cli, "PLAN", get_planner_prompt(story), plan_file, timeout)
+
+    print_phase("PLAN", "finishing the streamed draft")
+    draft_thread.join()
+    draft_output, draft_code = results.get("draft", ("", -1))
+    if draft_code != 0:
+        replan(f"Plan draft failed (exit {draft_code})")
+        return
+    if not plan_file.exists() or plan_file.stat().st_mtime < draft_started:
+        plan_file.parent.mkdir(parents=True, exist_ok=True)
+        plan_file.write_text(draft_output)
+    print(f"  {Colors.GRAY}[stream]{Colors.RESET} planning overlapped research by "
+          f"{research_done - draft_started:.0f}s")
+
+    late = [block for heading, block in _final_sections(research_file, complete=True)
+            if drafted.get(heading) != block]
+    if not late:
+        print(f"  {Colors.GREEN}✓ {plan_file.name} created (no late research){Colors.RESET}")
+        return
+    print(f"  {Colors.CYAN}[stream]{Colors.RESET} folding {len(late)} late section(s) into the plan")
+    _, finish_code = run_cli(cli, get_plan_finish_prompt(story, "\n\n".join(late)), timeout=timeout,
+                             usage_label="rpi:plan:finish")
+    if finish_code != 0:
+        replan(f"Plan finishing pass failed (exit {finish_code})")
+        return
+    print(f"  {Colors.GREEN}✓ {plan_file.name} updated{Colors.RESET}")
+
+
+# ============================================================================
+# PARALLEL IMPLEMENTATION
+# ============================================================================
+
+def run_parallel_implement(cli: str, story: dict, version: int, timeout: int) -> bool:
+    """Implement independent plan steps concurrently; False means use the single implementer."""
+    plan_file = PLANS_DIR / f"{story.get('id', 'US-1')}_plan.md"
+    steps = parse_steps(plan_file.read_text() if plan_file.exists() else "")
+    if len(steps) < 2:
+        return False
+    waves = schedule_waves(steps)
+    if all(len(wave) == 1 for wave in waves):
+        return False
+
+    print_phase("IMPLEMENT", f"{len(steps)} plan steps in {len(waves)} wave(s)")
+
+    def run_step(step: Step, cwd: Path) -> tuple[str, int]:
+        with attribute("step", step.id):
+            return run_cli(cli, get_step_prompt(story, version, step), timeout=timeout, workspace=cwd,
+                           show_output=False, usage_label="rpi:implement:step")
+
+    results = run_plan_steps(steps, run_step)
+    if results is None:
+        return False
+
+    submission = SUBMISSION_DIR / f"V{version}" / "SUBMISSION.md"
+    if not submission.exists():
+        submission.parent.mkdir(parents=True, exist_ok=True)
+        submission.write_text(submission_summary(version, results))
+    print(f"  {Colors.GREEN}✓ {submission.name} created{Colors.RESET}")
+    return True
+
+
 def run_rpi_iteration(cli: str, story: dict, version: int,
                       timeout: int, prev_grading: str = "") -> int:
     """Run one full RPI iteration."""
@@ -213,29 +449,34 @@ def run_rpi_iteration(cli: str, story: dict, version: int,
     for d in [RESEARCH_DIR, PLANS_DIR, SUBMISSION_DIR / f"V{version}", GRADING_DIR]:
         d.mkdir(parents=True, exist_ok=True)
 
-    # Phase 1: Research
-    run_phase(
-        cli, "RESEARCH",
-        get_researcher_prompt(story, prev_grading),
-        RESEARCH_DIR / f"{story.get('id', 'US-1')}_research.md",
-        timeout
-    )
-
-    # Phase 2: Plan
-    run_phase(
-        cli, "PLAN",
-        get_planner_prompt(story),
-        PLANS_DIR / f"{story.get('id', 'US-1')}_plan.md",
-        timeout
-    )
-
-    # Phase 3: Implement
-    run_phase(
-        cli, "IMPLEMENT",
-        get_implementer_prompt(story, version),
-        SUBMISSION_DIR / f"V{version}" / "SUBMISSION.md",
-        timeout
-    )
+    if rpi_streaming_enabled():
+        # Phases 1+2 overlapped: the planner starts on early research sections
+        run_research_and_plan(cli, story, prev_grading, timeout)
+    else:
+        # Phase 1: Research
+        run_phase(
+            cli, "RESEARCH",
+            get_researcher_prompt(story, prev_grading),
+            RESEARCH_DIR / f"{story.get('id', 'US-1')}_research.md",
+            timeout
+        )
+
+        # Phase 2: Plan
+        run_phase(
+            cli, "PLAN",
+            get_planner_prompt(story),
+            PLANS_DIR / f"{story.get('id', 'US-1')}_plan.md",
+            timeout
+        )
+
+    # Phase 3: Implement (independent plan steps concurrently when enabled)
+    if not (parallel_steps_enabled() and run_parallel_implement(cli, story, version, timeout)):
+        run_phase(
+            cli, "IMPLEMENT",
+            get_implementer_prompt(story, version),
+            SUBMISSION_DIR / f"V{version}" / "SUBMISSION.md",
+            timeout
+        )
 
     # Phase 4: Grade
     grading_output, _ = run_phase(
@@ -255,8 +496,9 @@ def run_rpi_iteration(cli: str, story: dict, version: int,
 # MAIN LOOP
 # ============================================================================
 
-def run_loop(cli: str, max_iter: int = MAX_ITERATIONS, timeout: int = DEFAULT_TIMEOUT):
-    """Run the full RPI loop."""
+def run_loop(cli: str, max_iter: int = MAX_ITERATIONS, timeout: int = DEFAULT_TIMEOUT,
+             deadline: Optional[str] = None):
+    """Run the full RPI loop; a deadline caps the iterations to those that fit."""
     print_header(
         "RPI LOOP",
         "Research → Plan → Implement → Grade"
@@ -280,12 +522,20 @@ def run_loop(cli: str, max_iter: int = MAX_ITERATIONS, timeout: int = DEFAULT_TI
     version = state.version + 1
     prev_grading = ""
 
+    if deadline:
+        fits = rpi_iterations_within(deadline, max_iter - version + 1, EtaModel())
+        print(f"  {Colors.CYAN}Deadline:{Colors.RESET} {deadline} ({fits} iteration(s) fit)")
+        if fits < max_iter - version + 1:
+            print(f"  {Colors.YELLOW}⚠ Deadline limits retries to {fits} iteration(s){Colors.RESET}")
+        max_iter = version - 1 + fits
+
     for iteration in range(version, max_iter + 1):
         state.version = iteration
         state.iteration = iteration
         save_state(state, STATE_FILE)
 
-        score = run_rpi_iteration(cli, story, iteration, timeout, prev_grading)
+        with attribute("story", story.get("id", "US-1")), attribute("iteration", f"V{iteration}"):
+            score = run_rpi_iteration(cli, story, iteration, timeout, prev_grading)
 
         state.score = score
         state.history.append({
@@ -362,6 +612,7 @@ def main():
     common.add_argument("--cli", choices=["claude", "copilot"], default="claude")
     common.add_argument("--timeout", type=int, default=DEFAULT_TIMEOUT)
     common.add_argument("--max-iter", type=int, default=MAX_ITERATIONS)
+    common.add_argument("--deadline", type=deadline_arg, help="Duration (90m, 2h, 1d) or ISO timestamp")
 
     subparsers.add_parser("start", parents=[common])
     subparsers.add_parser("resume", parents=[common])
@@ -375,10 +626,10 @@ def main():
     if args.command == "start":
         if STATE_FILE.exists():
             STATE_FILE.unlink()
-        run_loop(args.cli, args.max_iter, args.timeout)
+        run_loop(args.cli, args.max_iter, args.timeout, args.deadline)
 
     elif args.command == "resume":
-        run_loop(args.cli, args.max_iter, args.timeout)
+        run_loop(args.cli, args.max_iter, args.timeout, args.deadline)
 
     elif args.command == "status":
         show_status()
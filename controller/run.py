@@ -15,14 +15,30 @@ sys.path.insert(0, str(Path(__file__).parent))
 
 try:
     from .orchestrator import Orchestrator
-    from .utils import Colors
+    from .utils import Colors, print_trace_report, print_prompt_profile, print_rusage_report
     from .rpi_loop import run_loop, show_status, load_state, get_current_story
     from .tracer import Tracer
+    from . import simulator
+    from . import evaluate
+    from . import cachebundle
+    from . import costreport
+    from .scheduler import deadline_arg
+    from .memprofile import start_profiling, memprofile_enabled
+    from .dashboard import start_dashboard, dashboard_enabled, prompting
+    from .fairshare import parse_tags
 except ImportError:
     from orchestrator import Orchestrator
-    from utils import Colors
+    from utils import Colors, print_trace_report, print_prompt_profile, print_rusage_report
     from rpi_loop import run_loop, show_status, load_state, get_current_story
     from tracer import Tracer
+    import simulator
+    import evaluate
+    import cachebundle
+    import costreport
+    from scheduler import deadline_arg
+    from memprofile import start_profiling, memprofile_enabled
+    from dashboard import start_dashboard, dashboard_enabled, prompting
+    from fairshare import parse_tags
 
 
 def cmd_status(args):
@@ -82,7 +98,7 @@ def cmd_run(args):
 
     result = orch.run_task(task, timeout=args.timeout)
 
-    if result.status.value == "completed":
+    if result.status == "completed":
         print(f"\n{Colors.GREEN}✓ Task completed{Colors.RESET}")
     else:
         print(f"\n{Colors.RED}✗ Task failed: {result.error}{Colors.RESET}")
@@ -95,10 +111,10 @@ def cmd_rpi(args):
         from rpi_loop import STATE_FILE
         if STATE_FILE.exists():
             STATE_FILE.unlink()
-        run_loop(args.cli, args.max_iter, args.timeout)
+        run_loop(args.cli, args.max_iter, args.timeout, args.deadline)
 
     elif args.subcommand == "resume":
-        run_loop(args.cli, args.max_iter, args.timeout)
+        run_loop(args.cli, args.max_iter, args.timeout, args.deadline)
 
     elif args.subcommand == "status":
         show_status()
@@ -129,6 +145,7 @@ def cmd_parallel(args):
             name=f"Parallel: {agent_name}",
             agent=agent_name,
             prompt=args.prompt,
+            tags=parse_tags(args.tenant),
         )
         tasks.append(task)
 
@@ -144,9 +161,9 @@ def cmd_parallel(args):
     print(f"{Colors.CYAN}{'═' * 60}{Colors.RESET}")
 
     for result in results:
-        status_icon = "✓" if result.status.value == "completed" else "✗"
-        status_color = Colors.GREEN if result.status.value == "completed" else Colors.RED
-        print(f"  {status_color}{status_icon}{Colors.RESET} {result.agent}: {result.status.value}")
+        status_icon = "✓" if result.status == "completed" else "✗"
+        status_color = Colors.GREEN if result.status == "completed" else Colors.RED
+        print(f"  {status_color}{status_icon}{Colors.RESET} {result.agent}: {result.status}")
 
 
 def cmd_tracer(args):
@@ -154,21 +171,24 @@ def cmd_tracer(args):
     tracer = Tracer(cli=args.cli)
 
     if args.subcommand == "start":
+        deadline = args.deadline
         if args.request:
-            tracer.start(args.request)
+            tracer.start(args.request, deadline=deadline)
         else:
             print(f"\n{Colors.CYAN}What would you like to accomplish?{Colors.RESET}")
             request = input(f"{Colors.YELLOW}> {Colors.RESET}")
             if request.strip():
-                tracer.start(request)
+                tracer.start(request, deadline=deadline)
     elif args.subcommand == "run":
+        deadline = args.deadline
         if args.request:
-            tracer.run_all(args.request)
+            tracer.run_all(args.request, deadline=deadline)
         else:
-            print(f"\n{Colors.CYAN}What would you like to accomplish?{Colors.RESET}")
-            request = input(f"{Colors.YELLOW}> {Colors.RESET}")
+            with prompting():
+                print(f"\n{Colors.CYAN}What would you like to accomplish?{Colors.RESET}")
+                request = input(f"{Colors.YELLOW}> {Colors.RESET}")
             if request.strip():
-                tracer.run_all(request)
+                tracer.run_all(request, deadline=deadline)
 
     elif args.subcommand == "status":
         tracer.print_status()
@@ -182,6 +202,12 @@ def cmd_tracer(args):
         else:
             print(f"{Colors.RED}Ticket not found: {args.ticket_id}{Colors.RESET}")
 
+    elif args.subcommand == "schedule":
+        tracer.schedule(run=args.run, strict=args.strict)
+
+    elif args.subcommand == "similar":
+        tracer.print_similar(args.request)
+
     elif args.subcommand == "list":
         print(f"\n{Colors.CYAN}Specs:{Colors.RESET}")
         for sid, spec in tracer.specs.items():
@@ -194,6 +220,53 @@ def cmd_tracer(args):
         print()
 
 
+def cmd_trace(args):
+    """Summarize tool-call traces from state/trace.jsonl."""
+    print()
+    print(f"{Colors.CYAN}{'═' * 60}{Colors.RESET}")
+    print(f"{Colors.CYAN}  Tool-Call Traces{Colors.RESET}")
+    print(f"{Colors.CYAN}{'═' * 60}{Colors.RESET}")
+    print_trace_report(limit=args.limit)
+
+
+def cmd_prompts(args):
+    """Summarize prompt composition profiles from state/prompt_profile.jsonl."""
+    print()
+    print(f"{Colors.CYAN}{'═' * 60}{Colors.RESET}")
+    print(f"{Colors.CYAN}  Prompt Composition{Colors.RESET}")
+    print(f"{Colors.CYAN}{'═' * 60}{Colors.RESET}")
+    print_prompt_profile(label=args.label, limit=args.limit, days=args.days)
+
+
+def cmd_rusage(args):
+    """Summarize local CPU, memory and I/O per label from state/usage.jsonl."""
+    print()
+    print(f"{Colors.CYAN}{'═' * 60}{Colors.RESET}")
+    print(f"{Colors.CYAN}  Agent Resource Usage{Colors.RESET}")
+    print(f"{Colors.CYAN}{'═' * 60}{Colors.RESET}")
+    print_rusage_report(limit=args.limit, days=args.days)
+
+
+def cmd_simulate(args):
+    """Replay recorded usage under hypothetical capacity settings."""
+    simulator.run_simulation(args)
+
+
+def cmd_eval(args):
+    """Replay recorded prompts against candidate models."""
+    evaluate.run_eval(args)
+
+
+def cmd_cache(args):
+    """Export or import CLI cache bundles."""
+    cachebundle.run_cache(args)
+
+
+def cmd_cost(args):
+    """Roll usage up the story → ticket → task → phase tree."""
+    costreport.run_report(args)
+
+
 def cmd_workflow(args):
     """Run a predefined workflow."""
     # NOTE: Workflow feature is not yet implemented
@@ -218,6 +291,15 @@ Examples:
   ./run.py workflow rpi                     # Run RPI workflow
   ./run.py tracer start "Fix the CSV bug"   # Start Tracer workflow
   ./run.py tracer status                    # Show Tracer status
+  ./run.py tracer similar "Fix the CSV bug" # Prior specs a request would reuse
+  ./run.py trace                            # Summarize tool-call traces
+  ./run.py prompts --label rpi              # Token share/truncation per prompt section
+  ./run.py rusage                           # Which agents are bound by local work?
+  ./run.py simulate --workers 1,2,4         # Predict makespan/cost per worker count
+  ./run.py eval run --models copilot:gpt-5.1-codex-mini,claude:haiku
+  ./run.py cache export ci-cache.tar.gz --label rpi:research,tracer:clarify --max-age 7d
+  ./run.py cost --by ticket                 # Which ticket cost the most?
+  ./run.py --dashboard parallel "locator,researcher" "Find CSV code"
         """
     )
 
@@ -226,6 +308,10 @@ Examples:
                        help="CLI to use (default: claude)")
     parser.add_argument("--timeout", type=int, default=600,
                        help="Timeout in seconds (default: 600)")
+    parser.add_argument("--memprofile", action="store_true",
+                       help="Snapshot allocations per phase into state/profiles/")
+    parser.add_argument("--dashboard", action="store_true",
+                       help="Live per-agent view during parallel and Tracer runs (TTY only)")
 
     subparsers = parser.add_subparsers(dest="command", required=True)
 
@@ -246,8 +332,10 @@ Examples:
     rpi_sub = rpi_p.add_subparsers(dest="subcommand", required=True)
     rpi_start = rpi_sub.add_parser("start", help="Start fresh")
     rpi_start.add_argument("--max-iter", type=int, default=10)
+    rpi_start.add_argument("--deadline", type=deadline_arg, help="Duration (90m, 2h, 1d) or ISO timestamp")
     rpi_resume = rpi_sub.add_parser("resume", help="Resume from state")
     rpi_resume.add_argument("--max-iter", type=int, default=10)
+    rpi_resume.add_argument("--deadline", type=deadline_arg, help="Duration (90m, 2h, 1d) or ISO timestamp")
     rpi_sub.add_parser("status", help="Show RPI status")
     rpi_sub.add_parser("reset", help="Reset RPI state")
 
@@ -256,6 +344,38 @@ Examples:
     parallel_p.add_argument("agents", help="Comma-separated agent names")
     parallel_p.add_argument("prompt", help="Shared prompt")
     parallel_p.add_argument("--workers", type=int, default=3)
+    parallel_p.add_argument("--tenant", help="Fair-share tags, e.g. user=alice,story=US-3")
+
+    # Trace command
+    trace_p = subparsers.add_parser("trace", help="Summarize tool-call traces")
+    trace_p.add_argument("--limit", type=int, default=10)
+
+    # Prompts command
+    prompts_p = subparsers.add_parser("prompts", help="Token share and truncation per prompt section")
+    prompts_p.add_argument("--label", help="Only labels starting with this prefix")
+    prompts_p.add_argument("--days", type=int, help="Only the last N days")
+    prompts_p.add_argument("--limit", type=int, default=10)
+
+    # Rusage command
+    rusage_p = subparsers.add_parser("rusage", help="Local CPU, peak memory and block I/O per label")
+    rusage_p.add_argument("--days", type=int, help="Only the last N days")
+    rusage_p.add_argument("--limit", type=int, default=20)
+
+    # Simulate command
+    sim_p = subparsers.add_parser("simulate", help="Simulate recorded workloads under other capacity settings")
+    simulator.add_arguments(sim_p)
+
+    # Eval command
+    eval_p = subparsers.add_parser("eval", help="Evaluate candidate models per label on recorded prompts")
+    evaluate.add_arguments(eval_p)
+
+    # Cache command
+    cache_p = subparsers.add_parser("cache", help="Export/import CLI cache bundles")
+    cachebundle.add_arguments(cache_p)
+
+    # Cost command
+    cost_p = subparsers.add_parser("cost", help="Cost attribution tree and flamegraph export")
+    costreport.add_arguments(cost_p)
 
     # Workflow command
     wf_p = subparsers.add_parser("workflow", help="Run a workflow")
@@ -267,15 +387,32 @@ Examples:
     tracer_sub = tracer_p.add_subparsers(dest="subcommand", required=True)
     tracer_start = tracer_sub.add_parser("start", help="Start new work")
     tracer_start.add_argument("request", nargs="?", help="What to accomplish")
+    tracer_start.add_argument("--deadline", type=deadline_arg, help="Duration (90m, 2h, 1d) or ISO timestamp")
     tracer_run = tracer_sub.add_parser("run", help="Run full Tracer workflow without confirmation")
     tracer_run.add_argument("request", nargs="?", help="What to accomplish")
+    tracer_run.add_argument("--deadline", type=deadline_arg, help="Duration (90m, 2h, 1d) or ISO timestamp")
     tracer_sub.add_parser("status", help="Show Tracer status")
     tracer_resume = tracer_sub.add_parser("resume", help="Resume a ticket")
     tracer_resume.add_argument("ticket_id", help="Ticket ID")
     tracer_sub.add_parser("list", help="List specs and tickets")
+    tracer_similar = tracer_sub.add_parser("similar", help="Show prior specs similar to a request")
+    tracer_similar.add_argument("request", help="Request text")
+    tracer_schedule = tracer_sub.add_parser("schedule", help="Order open tickets earliest-deadline-first")
+    tracer_schedule.add_argument("--run", action="store_true", help="Execute tickets in EDF order")
+    tracer_schedule.add_argument("--strict", action="store_true",
+                                 help="Defer tickets that cannot meet their deadline")
 
     args = parser.parse_args()
 
+    if args.memprofile or memprofile_enabled():
+        start_profiling()
+
+    # Tracer run also asks clarifying questions; the view steps aside for them (prompting())
+    live = args.command == "parallel" or (
+        args.command == "tracer" and args.subcommand in ("run", "resume", "schedule"))
+    if live and (args.dashboard or dashboard_enabled()):
+        start_dashboard()
+
     # Route to command handler
     handlers = {
         "status": cmd_status,
@@ -284,6 +421,13 @@ Examples:
         "rpi": cmd_rpi,
         "parallel": cmd_parallel,
         "workflow": cmd_workflow,
+        "trace": cmd_trace,
+        "prompts": cmd_prompts,
+        "rusage": cmd_rusage,
+        "simulate": cmd_simulate,
+        "eval": cmd_eval,
+        "cache": cmd_cache,
+        "cost": cmd_cost,
         "tracer": cmd_tracer,
     }
 
@@ -0,0 +1,260 @@
+#!/usr/bin/env python3
+"""
+Deadline-Aware Scheduling
+
+Earliest-deadline-first ordering of tickets and workflow runs:
+- ETA model built from recorded usage (per-label latency and cost)
+- Admission control with infeasibility warnings
+- Downgrades optional phases (extra review rounds) to meet deadlines
+- Usage statistics folded incrementally, so each start only parses new records
+"""
+from __future__ import annotations
+
+import os
+import re
+import json
+import argparse
+from datetime import datetime, timedelta
+from dataclasses import dataclass
+from typing import Optional
+
+try:
+    from .utils import STATE_DIR, USAGE_LOG, estimate_cost
+except ImportError:
+    from utils import STATE_DIR, USAGE_LOG, estimate_cost
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+# Fallback latencies (seconds) when a label has no recorded history
+DEFAULT_LATENCY = {
+    "tracer:execute:implement": 300.0,
+    "tracer:execute:review": 60.0,
+    "tracer:execute:verify": 120.0,
+    "tracer:execute:correct": 240.0,
+    "rpi:research": 300.0,
+    "rpi:plan": 240.0,
+    "rpi:implement": 450.0,
+    "rpi:grade": 240.0,
+}
+RPI_PHASES = ("rpi:research", "rpi:plan", "rpi:implement", "rpi:grade")
+
+# Iterations per pending task: full mode budgets for extra review/correct rounds;
+# lean mode implements each task once and skips the review (verify still runs)
+FULL_ROUNDS = 2
+LEAN_ROUNDS = 1
+# Full mode never gets fewer iterations than the original fixed budget
+MIN_FULL_ITERATIONS = 5
+
+ETA_STATS = STATE_DIR / "eta_stats.json"
+
+DURATION_RE = re.compile(r'^\s*(\d+(?:\.\d+)?)\s*([smhd])\s*$')
+DURATION_UNITS = {"s": 1, "m": 60, "h": 3600, "d": 86400}
+
+
+def parse_deadline(text: Optional[str], now: Optional[datetime] = None) -> Optional[str]:
+    """Parse "90m", "2h", "1d" or an ISO timestamp into an ISO deadline."""
+    if not text:
+        return None
+    now = now or datetime.now()
+    match = DURATION_RE.match(text)
+    if match:
+        seconds = float(match.group(1)) * DURATION_UNITS[match.group(2)]
+        return (now + timedelta(seconds=seconds)).isoformat(timespec="seconds")
+    return datetime.fromisoformat(text.strip()).isoformat(timespec="seconds")
+
+
+def deadline_arg(text: str) -> Optional[str]:
+    """argparse type for --deadline: a usage error instead of a traceback."""
+    try:
+        return parse_deadline(text)
+    except ValueError:
+        raise argparse.ArgumentTypeError(
+            f"invalid deadline '{text}' (use a duration like 90m, 2h, 1d or an ISO timestamp)")
+
+
+def ticket_iterations(pending_tasks: int, lean: bool = False) -> int:
+    """Iteration budget for a ticket; the ETA model assumes the same count."""
+    if lean:
+        return max(1, pending_tasks) * LEAN_ROUNDS
+    return max(MIN_FULL_ITERATIONS, pending_tasks * FULL_ROUNDS)
+
+
+def _deadline_ts(deadline: Optional[str]) -> Optional[float]:
+    if not deadline:
+        return None
+    try:
+        return datetime.fromisoformat(deadline).timestamp()
+    except ValueError:
+        return None
+
+
+# ============================================================================
+# ETA MODEL
+# ============================================================================
+
+def _fold(stats: dict, record: dict):
+    """Add one usage record to per-label {calls, seconds, tokens per model} sums."""
+    label = record.get("label", "")
+    if not label or label.endswith(":cache") or label.endswith(":aborted"):
+        return
+    entry = stats.setdefault(label, {"calls": 0, "seconds": 0.0, "models": {}})
+    entry["calls"] += 1
+    entry["seconds"] += float(record.get("elapsed_sec", 0.0))
+    # Tokens rather than dollars: cost is linear in tokens, and prices can change
+    tokens = entry["models"].setdefault(record.get("model") or "", [0, 0])
+    tokens[0] += record.get("in_tokens", 0)
+    tokens[1] += record.get("out_tokens", 0)
+
+
+def usage_stats() -> dict:
+    """
+    Per-label sums over usage.jsonl, cached in state/eta_stats.json with the
+    byte offset they cover; only records appended since are parsed.
+    """
+    stats, offset = {}, 0
+    try:
+        cached = json.loads(ETA_STATS.read_text())
+        stats, offset = cached["labels"], cached["offset"]
+    except (OSError, ValueError, KeyError):
+        pass
+    try:
+        size = USAGE_LOG.stat().st_size
+    except OSError:
+        return {}
+    if size < offset:
+        stats, offset = {}, 0  # log truncated or replaced
+    if size == offset:
+        return stats
+
+    with USAGE_LOG.open("rb") as f:
+        f.seek(offset)
+        chunk = f.read(size - offset)
+    # A half-written last line is picked up next time
+    end = chunk.rfind(b"\n") + 1
+    for line in chunk[:end].splitlines():
+        try:
+            _fold(stats, json.loads(line))
+        except ValueError:
+            continue
+    try:
+        tmp = ETA_STATS.with_suffix(f".{os.getpid()}.tmp")
+        tmp.write_text(json.dumps({"offset": offset + end, "labels": stats}))
+        os.replace(tmp, ETA_STATS)
+    except OSError:
+        pass
+    return stats
+
+
+class EtaModel:
+    """Per-label mean latency and cost learned from usage.jsonl."""
+
+    def __init__(self, records: Optional[list[dict]] = None):
+        if records is None:
+            stats = usage_stats()
+        else:
+            stats = {}
+            for r in records:
+                _fold(stats, r)
+        self.latency = {k: e["seconds"] / e["calls"] for k, e in stats.items() if e["calls"]}
+        self.cost = {k: sum(estimate_cost(m or None, i, o) for m, (i, o) in e["models"].items()) / e["calls"]
+                     for k, e in stats.items() if e["calls"]}
+        implements = stats.get("tracer:execute:implement", {}).get("calls", 0)
+        corrections = stats.get("tracer:execute:correct", {}).get("calls", 0)
+        self.correction_rate = min(1.0, corrections / implements) if implements else 0.5
+
+    def seconds(self, label: str) -> float:
+        return self.latency.get(label, DEFAULT_LATENCY.get(label, 120.0))
+
+    def dollars(self, label: str) -> float:
+        return self.cost.get(label, 0.0)
+
+    def tracer_round(self, lean: bool = False) -> tuple[float, float]:
+        """ETA and cost of one implement → (review ∥ verify) → maybe-correct round
+        (lean: implement → verify)."""
+        labels = ("tracer:execute:implement", "tracer:execute:review",
+                  "tracer:execute:verify", "tracer:execute:correct")
+        implement, review, verify, correct = (self.seconds(l) for l in labels)
+        if lean:
+            return implement + verify, self.dollars(labels[0]) + self.dollars(labels[2])
+        eta = implement + max(review, verify) + self.correction_rate * correct
+        dollars = (sum(self.dollars(l) for l in labels[:3])
+                   + self.correction_rate * self.dollars("tracer:execute:correct"))
+        return eta, dollars
+
+    def ticket(self, pending_tasks: int, lean: bool = False) -> tuple[float, float]:
+        rounds = ticket_iterations(pending_tasks, lean)
+        eta, dollars = self.tracer_round(lean)
+        return eta * rounds, dollars * rounds
+
+    def rpi_iteration(self) -> tuple[float, float]:
+        return (sum(self.seconds(p) for p in RPI_PHASES),
+                sum(self.dollars(p) for p in RPI_PHASES))
+
+
+# ============================================================================
+# EDF SCHEDULER
+# ============================================================================
+
+@dataclass
+class ScheduleEntry:
+    ticket_id: str
+    deadline: Optional[str]
+    eta_sec: float
+    cost_usd: float
+    finish_at: datetime
+    lean: bool
+    feasible: bool
+    admitted: bool
+
+
+def schedule_tickets(tickets: list, eta: EtaModel, now: Optional[datetime] = None,
+                     strict: bool = False) -> list[ScheduleEntry]:
+    """
+    Order tickets earliest-deadline-first and check feasibility in sequence.
+
+    A ticket that would miss its deadline is downgraded to lean mode (no
+    review/correct rounds; every task is still implemented). If it still
+    misses, it is flagged infeasible and, with strict admission, deferred so
+    it does not delay feasible work.
+    """
+    now = now or datetime.now()
+    order = sorted(
+        enumerate(tickets),
+        key=lambda it: (_deadline_ts(it[1].deadline) is None, _deadline_ts(it[1].deadline) or 0.0, it[0]),
+    )
+
+    clock = now
+    entries = []
+    for _, ticket in order:
+        pending = sum(1 for t in ticket.tasks if not t.get("done")) or 1
+        deadline_ts = _deadline_ts(ticket.deadline)
+
+        eta_sec, cost = eta.ticket(pending)
+        lean = False
+        if deadline_ts is not None and (clock + timedelta(seconds=eta_sec)).timestamp() > deadline_ts:
+            eta_sec, cost = eta.ticket(pending, lean=True)
+            lean = True
+
+        finish = clock + timedelta(seconds=eta_sec)
+        feasible = deadline_ts is None or finish.timestamp() <= deadline_ts
+        admitted = feasible or not strict
+        if admitted:
+            clock = finish
+        entries.append(ScheduleEntry(ticket.id, ticket.deadline, eta_sec, cost, finish, lean, feasible, admitted))
+    return entries
+
+
+def rpi_iterations_within(deadline: Optional[str], max_iter: int, eta: EtaModel,
+                          now: Optional[datetime] = None) -> int:
+    """How many RPI iterations fit before the deadline (at least one)."""
+    deadline_ts = _deadline_ts(deadline)
+    if deadline_ts is None:
+        return max_iter
+    per_iteration, _ = eta.rpi_iteration()
+    remaining = deadline_ts - (now or datetime.now()).timestamp()
+    if per_iteration <= 0:
+        return max_iter
+    return max(1, min(max_iter, int(remaining // per_iteration)))
@@ -0,0 +1,354 @@
+#!/usr/bin/env python3
+"""
+Capacity Simulator
+
+Discrete-event replay of recorded orchestration workloads:
+- Jobs and phase dependencies rebuilt from state/usage.jsonl
+- Hypothetical worker counts, rate limits, cache hit rates, model tiers
+- Predicts makespan, cost and queueing delay before paying for real runs
+"""
+from __future__ import annotations
+
+import json
+import heapq
+import random
+import statistics
+from datetime import datetime
+from dataclasses import dataclass, field
+from typing import Optional
+
+try:
+    from .utils import Colors, USAGE_LOG, load_usage_records, estimate_cost, model_prices
+except ImportError:
+    from utils import Colors, USAGE_LOG, load_usage_records, estimate_cost, model_prices
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+LABEL_SUFFIXES = (":cache", ":aborted")
+# Labels launched together: Tracer review/verify once the implementation finishes,
+# and RPI research alongside its streamed plan draft (ORCHESTRATOR_RPI_STREAM)
+CONCURRENT_GROUPS = ({"tracer:execute:review", "tracer:execute:verify"},
+                     {"rpi:research", "rpi:plan:draft"})
+# A family chain restarts when consecutive records are further apart than this
+FLOW_GAP_SEC = 3600
+
+
+# ============================================================================
+# DATA STRUCTURES
+# ============================================================================
+
+@dataclass
+class Job:
+    id: int
+    label: str
+    model: Optional[str]
+    in_tokens: int
+    out_tokens: int
+    elapsed: float
+    cached: bool = False
+    deps: list[int] = field(default_factory=list)
+
+
+@dataclass
+class SimSettings:
+    workers: int = 3
+    rate_limit_rpm: float = 0.0
+    cache_hit_rate: Optional[float] = None
+    latency_scale: dict[str, float] = field(default_factory=dict)
+    model_override: dict[str, str] = field(default_factory=dict)
+    seed: int = 0
+
+
+@dataclass
+class SimResult:
+    makespan: float
+    cost: float
+    mean_queue_delay: float
+    p95_queue_delay: float
+    utilization: float
+    jobs: int
+
+
+# ============================================================================
+# WORKLOAD
+# ============================================================================
+
+def base_label(label: str) -> str:
+    for suffix in LABEL_SUFFIXES:
+        if label.endswith(suffix):
+            return label[: -len(suffix)]
+    return label
+
+
+def _family(label: str) -> Optional[str]:
+    """Sequential family a label belongs to; orch:* tasks are independent."""
+    head = label.split(":", 1)[0]
+    return None if head == "orch" else head
+
+
+def _group(label: str) -> Optional[int]:
+    for i, group in enumerate(CONCURRENT_GROUPS):
+        if label in group:
+            return i
+    return None
+
+
+def load_workload(records: Optional[list[dict]] = None) -> list[Job]:
+    """Rebuild jobs and dependency edges from usage records."""
+    records = load_usage_records() if records is None else records
+    records = sorted((r for r in records if r.get("label")), key=lambda r: r.get("ts", ""))
+
+    jobs: list[Job] = []
+    # family -> (deps of the current sibling group, group id, ids in group, last ts)
+    chains: dict[str, dict] = {}
+    for r in records:
+        label = base_label(r["label"])
+        job = Job(
+            id=len(jobs), label=label, model=r.get("model"),
+            in_tokens=r.get("in_tokens", 0), out_tokens=r.get("out_tokens", 0),
+            elapsed=float(r.get("elapsed_sec", 0.0)), cached=r["label"].endswith(":cache"),
+        )
+        family = _family(label)
+        if family:
+            ts = _parse_ts(r.get("ts"))
+            chain = chains.get(family)
+            if chain and ts is not None and chain["ts"] is not None and ts - chain["ts"] > FLOW_GAP_SEC:
+                chain = None
+            group = _group(label)
+            if chain and group is not None and chain["group"] == group:
+                job.deps = list(chain["deps"])
+                chain["members"].append(job.id)
+            else:
+                job.deps = list(chain["members"]) if chain else []
+                chains[family] = chain = {"deps": job.deps, "group": group, "members": [job.id]}
+            chain["ts"] = ts
+        jobs.append(job)
+    return jobs
+
+
+def _parse_ts(ts: Optional[str]) -> Optional[float]:
+    try:
+        return datetime.fromisoformat(ts).timestamp()
+    except (TypeError, ValueError):
+        return None
+
+
+def recorded_busy_time(records: list[dict]) -> float:
+    """Wall time with at least one recorded call running; idle gaps between runs are left out."""
+    spans = []
+    for r in records:
+        end = _parse_ts(r.get("ts"))
+        if end is not None:
+            spans.append((end - float(r.get("elapsed_sec", 0.0)), end))
+    busy = 0.0
+    cover_start = cover_end = None
+    for start, end in sorted(spans):
+        if cover_end is None or start > cover_end:
+            if cover_end is not None:
+                busy += cover_end - cover_start
+            cover_start, cover_end = start, end
+        else:
+            cover_end = max(cover_end, end)
+    if cover_end is not None:
+        busy += cover_end - cover_start
+    return busy
+
+
+# ============================================================================
+# SIMULATION
+# ============================================================================
+
+def simulate(jobs: list[Job], settings: SimSettings) -> SimResult:
+    rng = random.Random(settings.seed)
+    prices = model_prices()
+
+    samples: dict[str, list[float]] = {}
+    for job in jobs:
+        if not job.cached and job.elapsed > 0:
+            samples.setdefault(job.label, []).append(job.elapsed)
+    observed_hit_rate = (sum(1 for j in jobs if j.cached) / len(jobs)) if jobs else 0.0
+    hit_rate = observed_hit_rate if settings.cache_hit_rate is None else settings.cache_hit_rate
+
+    def duration(job: Job) -> tuple[float, bool]:
+        if rng.random() < hit_rate:
+            return 0.0, True
+        pool = samples.get(job.label) or [job.elapsed]
+        scale = next((f for prefix, f in settings.latency_scale.items() if job.label.startswith(prefix)), 1.0)
+        return rng.choice(pool) * scale, False
+
+    def cost(job: Job) -> float:
+        model = next((m for prefix, m in settings.model_override.items() if job.label.startswith(prefix)), job.model)
+        return estimate_cost(model, job.in_tokens, job.out_tokens, prices)
+
+    waiting = {j.id: len(j.deps) for j in jobs}
+    children: dict[int, list[int]] = {}
+    for j in jobs:
+        for d in j.deps:
+            children.setdefault(d, []).append(j.id)
+
+    ready: list[tuple[float, int]] = [(0.0, j.id) for j in jobs if not j.deps]
+    heapq.heapify(ready)
+    running: list[tuple[float, int]] = []
+    free = max(1, settings.workers)
+    spacing = 60.0 / settings.rate_limit_rpm if settings.rate_limit_rpm > 0 else 0.0
+    next_slot = 0.0
+    now = 0.0
+    busy = 0.0
+    total_cost = 0.0
+    delays: list[float] = []
+    # One draw per job: a job deferred by the rate limit must not re-roll its cache hit
+    rolls: dict[int, tuple[float, bool]] = {}
+
+    while ready or running:
+        started = False
+        while ready and free > 0:
+            release, job_id = ready[0]
+            if release > now:
+                break
+            job = jobs[job_id]
+            if job_id not in rolls:
+                rolls[job_id] = duration(job)
+            dur, hit = rolls[job_id]
+            start = now
+            if not hit and spacing:
+                if next_slot > now:
+                    break
+                next_slot = now + spacing
+            heapq.heappop(ready)
+            delays.append(start - release)
+            free -= 1
+            busy += dur
+            if not hit:
+                total_cost += cost(job)
+            heapq.heappush(running, (start + dur, job_id))
+            started = True
+        if started:
+            continue
+
+        candidates = []
+        if running:
+            candidates.append(running[0][0])
+        if ready and ready[0][0] > now:
+            candidates.append(ready[0][0])
+        if spacing and ready and free > 0 and next_slot > now:
+            candidates.append(next_slot)
+        if not candidates:
+            break
+        now = max(now, min(candidates))
+
+        while running and running[0][0] <= now:
+            _, done = heapq.heappop(running)
+            free += 1
+            for child in children.get(done, []):
+                waiting[child] -= 1
+                if waiting[child] == 0:
+                    heapq.heappush(ready, (now, child))
+
+    delays.sort()
+    p95 = delays[min(len(delays) - 1, int(0.95 * len(delays)))] if delays else 0.0
+    capacity = now * max(1, settings.workers)
+    return SimResult(
+        makespan=now,
+        cost=total_cost,
+        mean_queue_delay=statistics.fmean(delays) if delays else 0.0,
+        p95_queue_delay=p95,
+        utilization=(busy / capacity) if capacity else 0.0,
+        jobs=len(jobs),
+    )
+
+
+def simulate_many(jobs: list[Job], settings: SimSettings, runs: int) -> dict:
+    results = []
+    for i in range(max(1, runs)):
+        seeded = SimSettings(**{**settings.__dict__, "seed": settings.seed + i})
+        results.append(simulate(jobs, seeded))
+
+    def stat(attr: str) -> dict:
+        values = [getattr(r, attr) for r in results]
+        return {"mean": statistics.fmean(values), "stdev": statistics.pstdev(values)}
+
+    return {
+        "workers": settings.workers,
+        "jobs": len(jobs),
+        "makespan_sec": stat("makespan"),
+        "cost_usd": stat("cost"),
+        "mean_queue_delay_sec": stat("mean_queue_delay"),
+        "p95_queue_delay_sec": stat("p95_queue_delay"),
+        "utilization": stat("utilization"),
+    }
+
+
+# ============================================================================
+# CLI
+# ============================================================================
+
+def _parse_pairs(raw: Optional[str], cast=str) -> dict:
+    pairs = {}
+    for item in (raw or "").split(","):
+        if "=" in item:
+            key, val = item.split("=", 1)
+            pairs[key.strip()] = cast(val.strip())
+    return pairs
+
+
+def run_simulation(args):
+    records = load_usage_records()
+    if not records:
+        print(f"{Colors.YELLOW}No usage records in {USAGE_LOG}{Colors.RESET}")
+        return
+    jobs = load_workload(records)
+    worker_counts = [int(w) for w in str(args.workers).split(",") if w.strip()]
+
+    reports = []
+    for workers in worker_counts:
+        settings = SimSettings(
+            workers=workers,
+            rate_limit_rpm=args.rpm,
+            cache_hit_rate=args.cache_hit,
+            latency_scale=_parse_pairs(args.latency_scale, float),
+            model_override=_parse_pairs(args.model),
+            seed=args.seed,
+        )
+        reports.append(simulate_many(jobs, settings, args.runs))
+
+    if args.json:
+        print(json.dumps({"recorded_busy_sec": recorded_busy_time(records), "scenarios": reports}, indent=2))
+        return
+
+    print()
+    print(f"{Colors.CYAN}═══ Capacity Simulation ═══{Colors.RESET}")
+    print(f"  {Colors.GRAY}{len(jobs)} jobs, recorded busy time {recorded_busy_time(records):.0f}s, "
+          f"{args.runs} run(s) per scenario{Colors.RESET}")
+    print()
+    print(f"  {'workers':>7}  {'makespan':>12}  {'cost':>10}  {'queue avg':>10}  {'queue p95':>10}  {'util':>6}")
+    for r in reports:
+        print(f"  {r['workers']:>7}  {r['makespan_sec']['mean']:>10.0f}s  "
+              f"${r['cost_usd']['mean']:>9.2f}  {r['mean_queue_delay_sec']['mean']:>9.1f}s  "
+              f"{r['p95_queue_delay_sec']['mean']:>9.1f}s  {r['utilization']['mean']:>5.0%}")
+    print()
+
+
+def add_arguments(parser):
+    parser.add_argument("--workers", default="1,2,4", help="Worker counts to compare (comma-separated)")
+    parser.add_argument("--rpm", type=float, default=0.0, help="Rate limit in CLI calls per minute (0 = none)")
+    parser.add_argument("--cache-hit", type=float, default=None, help="Cache hit rate (default: as recorded)")
+    parser.add_argument("--latency-scale", help="label=factor,... latency multipliers by label prefix")
+    parser.add_argument("--model", help="label=model,... reprice calls under another model tier")
+    parser.add_argument("--runs", type=int, default=20)
+    parser.add_argument("--seed", type=int, default=0)
+    parser.add_argument("--json", action="store_true")
+
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Capacity simulator")
+    add_arguments(parser)
+    run_simulation(parser.parse_args())
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""
+Spec Reuse
+
+Similarity index over past Tracer specs and tickets:
+- Documents built from the original request, title, description and
+  requirements of each refined spec, plus its ticket's task names
+- TF-IDF cosine similarity, rebuilt from specs/ and tickets/ on demand
+- The closest match above a threshold becomes the template for a new
+  request: clarification only asks about differences, and the ticket
+  adapts the prior task breakdown
+"""
+from __future__ import annotations
+
+import os
+import re
+import math
+from collections import Counter
+from dataclasses import dataclass
+from typing import Optional
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+DEFAULT_MIN_SIMILARITY = 0.55
+REQUEST_WEIGHT = 2          # the request text counts twice: it is what new requests look like
+REUSABLE_STATUSES = ("refined",)
+
+STOPWORDS = frozenset("""
+a an and are as at be by for from has have in into is it its of on or should so that the
+this to was we with will would can could add make use using please need want
+""".split())
+
+
+def spec_reuse_enabled() -> bool:
+    return os.getenv("ORCHESTRATOR_SPEC_REUSE") == "1"
+
+
+def min_similarity() -> float:
+    try:
+        return float(os.getenv("ORCHESTRATOR_SPEC_REUSE_MIN", DEFAULT_MIN_SIMILARITY))
+    except ValueError:
+        return DEFAULT_MIN_SIMILARITY
+
+
+def tokenize(text: str) -> list[str]:
+    return [w for w in re.findall(r"[a-z0-9_]{2,}", (text or "").lower()) if w not in STOPWORDS]
+
+
+# ============================================================================
+# INDEX
+# ============================================================================
+
+@dataclass
+class SpecMatch:
+    spec: object            # tracer.Spec
+    ticket: Optional[object]  # tracer.Ticket whose tasks serve as the template
+    score: float
+    duplicate: bool = False   # same request text: reuse spec and tasks without model calls
+
+
+def spec_request(spec) -> str:
+    return getattr(spec, "request", "") or spec.description
+
+
+def normalize_request(text: str) -> str:
+    return " ".join((text or "").split())
+
+
+def spec_document(spec, ticket=None) -> list[str]:
+    parts = [spec_request(spec)] * REQUEST_WEIGHT + [spec.title, spec.description, *spec.requirements]
+    if ticket is not None:
+        parts += [t.get("name", "") for t in ticket.tasks]
+    return tokenize(" ".join(parts))
+
+
+class SpecIndex:
+    """TF-IDF vectors of reusable specs; small enough to rebuild per request."""
+
+    def __init__(self, specs: dict, tickets: dict):
+        by_spec = {}
+        for t in tickets.values():
+            if t.tasks:
+                by_spec[t.spec_id] = t
+        self.entries = [(s, by_spec.get(s.id)) for s in specs.values()
+                        if s.status in REUSABLE_STATUSES and s.title and s.requirements]
+        docs = [Counter(spec_document(s, t)) for s, t in self.entries]
+        df = Counter(term for doc in docs for term in doc)
+        n = len(docs)
+        self.idf = {term: math.log((1 + n) / (1 + count)) + 1 for term, count in df.items()}
+        self.vectors = [self._vector(doc) for doc in docs]
+        # Requests alone, so a short request can match a prior one closely
+        self.request_vectors = [self._vector(Counter(tokenize(spec_request(s)))) for s, _ in self.entries]
+        # Only the same text (up to whitespace) is a duplicate: word overlap ignores
+        # order and stopwords, so "from postgres to mysql" would equal its reverse
+        self.requests = [normalize_request(getattr(s, "request", "")) for s, _ in self.entries]
+
+    def _vector(self, counts: Counter) -> dict[str, float]:
+        # Unseen query terms still weigh in (at max idf) so new topics lower the score
+        max_idf = max(self.idf.values(), default=1.0)
+        vec = {term: (1 + math.log(c)) * self.idf.get(term, max_idf) for term, c in counts.items()}
+        norm = math.sqrt(sum(v * v for v in vec.values())) or 1.0
+        return {term: v / norm for term, v in vec.items()}
+
+    def search(self, request: str, limit: int = 5) -> list[SpecMatch]:
+        query = self._vector(Counter(tokenize(request)))
+        text = normalize_request(request)
+        matches = []
+        for i, (spec, ticket) in enumerate(self.entries):
+            score = max(sum(w * vec.get(term, 0.0) for term, w in query.items())
+                        for vec in (self.vectors[i], self.request_vectors[i]))
+            if score > 0:
+                matches.append(SpecMatch(spec, ticket, round(min(score, 1.0), 3),
+                                         duplicate=bool(text) and text == self.requests[i]))
+        matches.sort(key=lambda m: m.score, reverse=True)
+        return matches[:limit]
+
+    def best(self, request: str, threshold: Optional[float] = None) -> Optional[SpecMatch]:
+        matches = self.search(request, limit=1)
+        threshold = min_similarity() if threshold is None else threshold
+        return matches[0] if matches and matches[0].score >= threshold else None
+
+
+# ============================================================================
+# TEMPLATES
+# ============================================================================
+
+def template_text(match: SpecMatch) -> str:
+    """Prior request, spec and task breakdown as prompt context."""
+    spec = match.spec
+    lines = [f"PRIOR REQUEST: {spec_request(spec)}",
+             f"TITLE: {spec.title}",
+             f"DESCRIPTION: {spec.description}",
+             "REQUIREMENTS:", *[f"- {r}" for r in spec.requirements],
+             "ACCEPTANCE:", *[f"- {a}" for a in spec.acceptance_criteria]]
+    if spec.constraints:
+        lines += ["CONSTRAINTS:", *[f"- {c}" for c in spec.constraints]]
+    if spec.out_of_scope:
+        lines += ["OUT_OF_SCOPE:", *[f"- {o}" for o in spec.out_of_scope]]
+    if match.ticket is not None:
+        lines += ["TASKS:", *[f"- {t.get('name', '')} ({t.get('type', 'code')})" for t in match.ticket.tasks]]
+    return "\n".join(lines)
+
+
+def template_tasks(match: SpecMatch) -> list[dict]:
+    if match.ticket is None:
+        return []
+    return [{"name": t["name"], "type": t.get("type", "code"), "done": False}
+            for t in match.ticket.tasks if t.get("name")]
@@ -0,0 +1,331 @@
+#!/usr/bin/env python3
+"""
+Parallel Plan Steps
+
+Runs independent plan steps of the RPI implement phase concurrently:
+- Plans declare steps with dependencies and file scopes in a ```steps block
+- Steps are grouped into waves: dependencies satisfied, scopes disjoint
+- Each step runs in its own git worktree of a snapshot of the workspace
+- Step diffs are merged back in a fixed order; a step whose diff no longer
+  applies is re-run in the workspace itself
+"""
+from __future__ import annotations
+
+import os
+import re
+import json
+import shutil
+import threading
+import subprocess
+from pathlib import Path
+from dataclasses import dataclass, field
+from concurrent.futures import ThreadPoolExecutor
+from typing import Optional, Callable
+
+try:
+    from .utils import Colors, WORKSPACE, STATE_DIR, in_current_context
+except ImportError:
+    from utils import Colors, WORKSPACE, STATE_DIR, in_current_context
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+WORKTREE_DIR = STATE_DIR / "worktrees"
+STEPS_BLOCK_RE = re.compile(r"```steps[ \t]*\n([\s\S]*?)```")
+DEFAULT_STEP_WORKERS = 3
+
+
+def parallel_steps_enabled() -> bool:
+    return os.getenv("ORCHESTRATOR_RPI_PARALLEL") == "1"
+
+
+def step_workers() -> int:
+    try:
+        return max(1, int(os.getenv("ORCHESTRATOR_RPI_WORKERS", DEFAULT_STEP_WORKERS)))
+    except ValueError:
+        return DEFAULT_STEP_WORKERS
+
+
+STEPS_INSTRUCTIONS = """
+## Steps Block (required)
+End the plan with a fenced block tagged `steps`, listing every step as JSON:
+
+```steps
+[{"id": "S1", "title": "Parse header row", "deps": [], "files": ["src/csv.c", "src/csv.h"]},
+ {"id": "S2", "title": "Add label tests", "deps": ["S1"], "files": ["tests/"]}]
+```
+
+`deps` are the step ids that must land first. `files` are the paths or directories the
+step may modify; steps whose scopes do not overlap run in parallel, so keep scopes tight.
+"""
+
+
+# ============================================================================
+# STEP GRAPH
+# ============================================================================
+
+@dataclass
+class Step:
+    id: str
+    title: str
+    deps: list[str] = field(default_factory=list)
+    files: list[str] = field(default_factory=list)
+
+
+def parse_steps(plan_text: str) -> list[Step]:
+    """Steps from the plan's ```steps block; [] if missing, malformed or cyclic."""
+    match = STEPS_BLOCK_RE.search(plan_text or "")
+    if not match:
+        return []
+    try:
+        raw = json.loads(match.group(1))
+    except ValueError:
+        return []
+    if not isinstance(raw, list):
+        return []
+
+    steps = []
+    for item in raw:
+        if not isinstance(item, dict) or not item.get("id"):
+            return []
+        # Ids come from model output; never let one look like a path
+        step_id = str(item["id"])
+        if "/" in step_id or "\\" in step_id or ".." in step_id:
+            return []
+        steps.append(Step(
+            id=step_id,
+            title=str(item.get("title", "")),
+            deps=[str(d) for d in item.get("deps") or []],
+            files=[_scope_path(f) for f in item.get("files") or [] if str(f).strip()],
+        ))
+    ids = {s.id for s in steps}
+    if len(ids) != len(steps) or any(d not in ids for s in steps for d in s.deps):
+        return []
+    try:
+        schedule_waves(steps)
+    except ValueError:
+        return []
+    return steps
+
+
+def _scopes_overlap(a: Step, b: Step) -> bool:
+    # An undeclared scope may touch anything
+    if not a.files or not b.files:
+        return True
+    for x in a.files:
+        for y in b.files:
+            x_dir, y_dir = x.rstrip("/") + "/", y.rstrip("/") + "/"
+            if x == y or x_dir.startswith(y_dir) or y_dir.startswith(x_dir):
+                return True
+    return False
+
+
+def schedule_waves(steps: list[Step]) -> list[list[Step]]:
+    """Waves of steps to run concurrently; deterministic for a given plan."""
+    done: set[str] = set()
+    remaining = list(steps)
+    waves = []
+    while remaining:
+        ready = [s for s in remaining if all(d in done for d in s.deps)]
+        if not ready:
+            raise ValueError("dependency cycle in plan steps")
+        wave: list[Step] = []
+        for step in ready:
+            if not any(_scopes_overlap(step, other) for other in wave):
+                wave.append(step)
+        waves.append(wave)
+        done.update(s.id for s in wave)
+        remaining = [s for s in remaining if s.id not in done]
+    return waves
+
+
+# ============================================================================
+# GIT WORKTREES
+# ============================================================================
+
+def _git(cwd: Path, *args: str, env: Optional[dict] = None,
+         input_text: Optional[str] = None) -> subprocess.CompletedProcess:
+    return subprocess.run(["git", *args], cwd=str(cwd), capture_output=True, text=True,
+                          input=input_text, env={**os.environ, **(env or {})}, timeout=120)
+
+
+class WorktreeSet:
+    """Snapshots of the workspace and per-step worktrees sharing its object store."""
+
+    def __init__(self, workspace: Path = WORKSPACE):
+        self.workspace = Path(workspace).resolve()
+        top = _git(self.workspace, "rev-parse", "--show-toplevel")
+        head = _git(self.workspace, "rev-parse", "--verify", "HEAD")
+        self.available = top.returncode == 0 and head.returncode == 0
+        self.root = Path(top.stdout.strip()) if self.available else self.workspace
+        self.prefix = _git(self.workspace, "rev-parse", "--show-prefix").stdout.strip() if self.available else ""
+        self.index = STATE_DIR / "worktrees.index"
+        # git serializes worktree metadata updates poorly across concurrent calls
+        self._lock = threading.Lock()
+
+    def snapshot(self, tree_dir: Path, parent: str) -> Optional[str]:
+        """Commit of the working tree at `tree_dir` (tracked + untracked, minus state/)
+        without touching HEAD, the real index or any branch."""
+        index = self.index.with_suffix(f".{os.getpid()}.{abs(hash(str(tree_dir)))}")
+        env = {"GIT_INDEX_FILE": str(index)}
+        index.parent.mkdir(parents=True, exist_ok=True)
+        try:
+            if _git(tree_dir, "read-tree", parent, env=env).returncode != 0:
+                return None
+            if _git(tree_dir, "add", "-A", "--", ":/", env=env).returncode != 0:
+                return None
+            # Orchestrator state (and the worktrees inside it) never travels with a step
+            _git(tree_dir, "rm", "-r", "-q", "-f", "--cached", "--ignore-unmatch", "--",
+                 f":(top){self.prefix}{STATE_DIR.name}", env=env)
+            tree = _git(tree_dir, "write-tree", env=env).stdout.strip()
+            commit = _git(tree_dir, "commit-tree", tree, "-p", parent, "-m", "rpi step snapshot",
+                          env={**env, "GIT_AUTHOR_NAME": "rpi", "GIT_AUTHOR_EMAIL": "rpi@localhost",
+                               "GIT_COMMITTER_NAME": "rpi", "GIT_COMMITTER_EMAIL": "rpi@localhost"})
+            return commit.stdout.strip() if commit.returncode == 0 else None
+        finally:
+            index.unlink(missing_ok=True)
+
+    def add(self, name: str, commit: str) -> Optional[Path]:
+        path = WORKTREE_DIR / name
+        if path.exists():
+            self.remove(path)
+        path.parent.mkdir(parents=True, exist_ok=True)
+        with self._lock:
+            if _git(self.root, "worktree", "add", "--detach", str(path), commit).returncode != 0:
+                return None
+        return path
+
+    def remove(self, path: Path):
+        with self._lock:
+            _git(self.root, "worktree", "remove", "--force", str(path))
+        shutil.rmtree(path, ignore_errors=True)
+
+    def prune(self):
+        _git(self.root, "worktree", "prune")
+
+    def diff(self, base: str, commit: str) -> tuple[str, list[str]]:
+        patch = _git(self.root, "diff", "--binary", base, commit).stdout
+        names = _git(self.root, "diff", "--name-only", base, commit).stdout.split()
+        return patch, names
+
+    def apply(self, patch: str) -> bool:
+        if not patch.strip():
+            return True
+        if _git(self.root, "apply", "--check", "--binary", "-", input_text=patch).returncode != 0:
+            return False
+        return _git(self.root, "apply", "--binary", "-", input_text=patch).returncode == 0
+
+
+# ============================================================================
+# EXECUTION
+# ============================================================================
+
+@dataclass
+class StepResult:
+    step: Step
+    code: int = -1
+    summary: str = ""
+    files: list[str] = field(default_factory=list)
+    out_of_scope: list[str] = field(default_factory=list)
+    merged: str = "pending"  # merged | rerun | failed | empty
+
+
+def _scope_path(raw) -> str:
+    """Workspace-relative form of a planned path; keeps leading dots (.github/, .eslintrc)."""
+    path = str(raw).strip()
+    while path.startswith("./"):
+        path = path.removeprefix("./")
+    return path.lstrip("/")
+
+
+def _in_scope(path: str, step: Step) -> bool:
+    return not step.files or any(
+        path == f or path.startswith(f.rstrip("/") + "/") for f in step.files)
+
+
+def run_plan_steps(steps: list[Step], run_step: Callable[[Step, Path], tuple[str, int]],
+                   workspace: Path = WORKSPACE) -> Optional[list[StepResult]]:
+    """
+    Execute steps wave by wave. `run_step(step, cwd)` runs the implementer for
+    one step in `cwd`. Returns None when worktrees are unavailable (caller
+    falls back to a single sequential implementer).
+    """
+    trees = WorktreeSet(workspace)
+    if not trees.available:
+        print(f"  {Colors.YELLOW}[steps]{Colors.RESET} workspace is not a git checkout with commits; "
+              f"running the plan sequentially")
+        return None
+
+    results: list[StepResult] = []
+    waves = schedule_waves(steps)
+    for n, wave in enumerate(waves, 1):
+        print(f"  {Colors.CYAN}[steps]{Colors.RESET} wave {n}/{len(waves)}: "
+              f"{', '.join(s.id for s in wave)}")
+        if len(wave) == 1:
+            # Nothing to isolate from: run in place
+            output, code = run_step(wave[0], workspace)
+            results.append(StepResult(wave[0], code, output[-2000:], merged="in place"))
+            continue
+
+        base = trees.snapshot(trees.root, "HEAD")
+        if base is None:
+            print(f"  {Colors.YELLOW}[steps]{Colors.RESET} snapshot failed; running wave {n} sequentially")
+            for step in wave:
+                output, code = run_step(step, workspace)
+                results.append(StepResult(step, code, output[-2000:], merged="in place"))
+            continue
+
+        def isolated(step: Step, slot: int) -> tuple[StepResult, Optional[str]]:
+            result = StepResult(step)
+            # Worktree dirs are named by position, not by the plan's step ids
+            tree = trees.add(f"wave{n}-{slot}", base)
+            if tree is None:
+                return result, None
+            try:
+                output, result.code = run_step(step, tree / trees.prefix)
+                result.summary = output[-2000:]
+                commit = trees.snapshot(tree, base)
+                if commit is None:
+                    return result, None
+                patch, result.files = trees.diff(base, commit)
+                result.out_of_scope = [f for f in result.files if not _in_scope(f, step)]
+                return result, patch
+            finally:
+                trees.remove(tree)
+
+        with ThreadPoolExecutor(max_workers=min(step_workers(), len(wave))) as pool:
+            outcomes = list(pool.map(in_current_context(isolated), wave, range(len(wave))))
+
+        # Merge in plan order so the result does not depend on finishing order
+        for result, patch in outcomes:
+            step = result.step
+            if result.out_of_scope:
+                print(f"  {Colors.YELLOW}[steps]{Colors.RESET} {step.id} touched files outside its scope: "
+                      f"{', '.join(result.out_of_scope[:5])}")
+            if patch is not None and result.code == 0 and trees.apply(patch):
+                result.merged = "merged" if patch.strip() else "empty"
+            else:
+                reason = "failed" if result.code != 0 or patch is None else "conflicted"
+                print(f"  {Colors.YELLOW}[steps]{Colors.RESET} {step.id} {reason}; re-running in the workspace")
+                output, result.code = run_step(step, workspace)
+                result.summary = output[-2000:]
+                result.merged = "rerun"
+            mark = Colors.GREEN + "✓" if result.code == 0 else Colors.RED + "✗"
+            print(f"  {mark}{Colors.RESET} {step.id} {step.title} ({result.merged}, {len(result.files)} file(s))")
+            results.append(result)
+    trees.prune()
+    return results
+
+
+def submission_summary(version: int, results: list[StepResult]) -> str:
+    lines = [f"# Submission V{version}", "", "Implemented as parallel plan steps.", ""]
+    for r in results:
+        lines += [f"## {r.step.id}: {r.step.title}",
+                  f"Status: {'done' if r.code == 0 else 'failed'} ({r.merged})", ""]
+        if r.files:
+            lines += ["Files: " + ", ".join(r.files), ""]
+        if r.summary.strip():
+            lines += [r.summary.strip()[-1500:], ""]
+    return "\n".join(lines)
@@ -0,0 +1,32 @@
+#!/usr/bin/env python3
+"""
+Stub Agent CLI
+
+Deterministic stand-in for an agent CLI, registered as CLI_CONFIGS["stub"]:
+- Echoes a digest of the prompt so outputs are checkable
+- ORCHESTRATOR_STUB_DELAY / ORCHESTRATOR_STUB_LINES shape latency and volume
+"""
+from __future__ import annotations
+
+import os
+import sys
+import time
+import hashlib
+
+
+def main():
+    args = sys.argv[1:]
+    prompt = args[args.index("-p") + 1] if "-p" in args and args.index("-p") + 1 < len(args) else sys.stdin.read()
+    delay = float(os.getenv("ORCHESTRATOR_STUB_DELAY", "0") or 0)
+    lines = int(os.getenv("ORCHESTRATOR_STUB_LINES", "3") or 3)
+
+    digest = hashlib.sha256(prompt.encode("utf-8")).hexdigest()
+    for i in range(lines):
+        print(f"stub line {i + 1}/{lines}", flush=True)
+        if delay:
+            time.sleep(delay / max(1, lines))
+    print(f"STUB-DIGEST: {digest}", flush=True)
+
+
+if __name__ == "__main__":
+    main()
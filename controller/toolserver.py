@@ -0,0 +1,395 @@
+#!/usr/bin/env python3
+"""
+Shared Read-Only Tool Server
+
+Hosts read-only tools (read_file, grep, glob) for every agent in a run:
+- In-process HTTP server owned by the orchestrator
+- Results cached by workspace fingerprint + tool arguments
+- Stdio MCP proxy that each agent's CLI launches to reach the server
+"""
+from __future__ import annotations
+
+import os
+import re
+import sys
+import json
+import time
+import fnmatch
+import threading
+import urllib.request
+from pathlib import Path
+from typing import Optional
+from http.server import ThreadingHTTPServer, BaseHTTPRequestHandler
+
+try:
+    from .utils import Colors, WORKSPACE, STATE_DIR
+    from .fingerprint import workspace_fingerprint, FINGERPRINT_SKIP_NAMES, FINGERPRINT_SKIP_PATHS
+except ImportError:
+    from utils import Colors, WORKSPACE, STATE_DIR
+    from fingerprint import workspace_fingerprint, FINGERPRINT_SKIP_NAMES, FINGERPRINT_SKIP_PATHS
+
+
+# ============================================================================
+# CONFIGURATION
+# ============================================================================
+
+TOOLSERVER_DIR = STATE_DIR / "toolserver"
+SERVER_NAME = "orch-tools"
+FINGERPRINT_TTL = 2.0
+MAX_READ_LINES = 2000
+MAX_GREP_RESULTS = 200
+
+TOOL_SCHEMAS = [
+    {
+        "name": "read_file",
+        "description": "Read a workspace file (shared cache). Returns numbered lines.",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "path": {"type": "string"},
+                "offset": {"type": "integer", "description": "First line (1-based)"},
+                "limit": {"type": "integer"},
+            },
+            "required": ["path"],
+        },
+    },
+    {
+        "name": "grep",
+        "description": "Regex search over workspace files (shared cache). Returns path:line: text.",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "pattern": {"type": "string"},
+                "path": {"type": "string"},
+                "glob": {"type": "string", "description": "Filename filter, e.g. *.py"},
+            },
+            "required": ["pattern"],
+        },
+    },
+    {
+        "name": "glob",
+        "description": "List workspace files matching a glob pattern (shared cache).",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "pattern": {"type": "string"},
+                "path": {"type": "string"},
+            },
+            "required": ["pattern"],
+        },
+    },
+]
+
+
+BLACKBOARD_SCHEMAS = [
+    {
+        "name": "post_finding",
+        "description": "Share a finding with the other agents in this run.",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "ref": {"type": "string", "description": "file:line reference"},
+                "note": {"type": "string", "description": "One-line finding"},
+                "agent": {"type": "string"},
+            },
+            "required": ["ref", "note"],
+        },
+    },
+    {
+        "name": "query_findings",
+        "description": "List findings other agents in this run have already posted.",
+        "inputSchema": {
+            "type": "object",
+            "properties": {
+                "query": {"type": "string", "description": "Optional substring filter"},
+            },
+        },
+    },
+]
+
+
+def tool_server_enabled() -> bool:
+    return os.getenv("ORCHESTRATOR_TOOL_SERVER") == "1"
+
+
+# ============================================================================
+# READ-ONLY TOOLS
+# ============================================================================
+
+def _walk(workspace: Path, root: Path):
+    # Same files the fingerprint covers, so cached results go stale exactly when they should;
+    # state/ etc. are skipped only at the workspace root, not wherever the name recurs
+    top = workspace.resolve()
+    for dirpath, dirnames, filenames in os.walk(root):
+        rel_dir = Path(dirpath).relative_to(top).as_posix()
+        prefix = "" if rel_dir == "." else f"{rel_dir}/"
+        dirnames[:] = [d for d in dirnames
+                       if d not in FINGERPRINT_SKIP_NAMES and prefix + d not in FINGERPRINT_SKIP_PATHS]
+        for name in filenames:
+            yield Path(dirpath) / name
+
+
+def _resolve(workspace: Path, rel: Optional[str]) -> Path:
+    path = (workspace / (rel or ".")).resolve()
+    path.relative_to(workspace.resolve())
+    return path
+
+
+def _fingerprinted(workspace: Path, rel: Optional[str]) -> bool:
+    """Whether the workspace fingerprint covers `rel`; results for anything else can go stale."""
+    try:
+        parts = _resolve(workspace, rel).relative_to(workspace.resolve()).parts
+    except (ValueError, OSError):
+        return False
+    if parts and parts[0] in FINGERPRINT_SKIP_PATHS:
+        return False
+    return not FINGERPRINT_SKIP_NAMES.intersection(parts)
+
+
+def tool_read_file(workspace: Path, path: str, offset: int = 1, limit: int = MAX_READ_LINES) -> str:
+    target = _resolve(workspace, path)
+    lines = target.read_text(errors="replace").splitlines()
+    start = max(1, int(offset or 1))
+    end = start + min(int(limit or MAX_READ_LINES), MAX_READ_LINES)
+    return "\n".join(f"{i:6d}\t{lines[i - 1]}" for i in range(start, min(end, len(lines) + 1)))
+
+
+def tool_grep(workspace: Path, pattern: str, path: str = ".", glob: Optional[str] = None) -> str:
+    regex = re.compile(pattern)
+    root = _resolve(workspace, path)
+    files = [root] if root.is_file() else sorted(_walk(workspace, root))
+    results = []
+    for f in files:
+        if glob and not fnmatch.fnmatch(f.name, glob):
+            continue
+        try:
+            text = f.read_text(errors="strict")
+        except (UnicodeDecodeError, OSError):
+            continue
+        for i, line in enumerate(text.splitlines(), 1):
+            if regex.search(line):
+                results.append(f"{f.relative_to(workspace)}:{i}: {line.strip()[:200]}")
+                if len(results) >= MAX_GREP_RESULTS:
+                    results.append(f"[truncated at {MAX_GREP_RESULTS} results]")
+                    return "\n".join(results)
+    return "\n".join(results)
+
+
+def tool_glob(workspace: Path, pattern: str, path: str = ".") -> str:
+    root = _resolve(workspace, path)
+    matches = []
+    for f in sorted(_walk(workspace, root)):
+        rel = str(f.relative_to(workspace))
+        if fnmatch.fnmatch(rel, pattern) or fnmatch.fnmatch(f.name, pattern):
+            matches.append(rel)
+    return "\n".join(matches)
+
+
+TOOLS = {
+    "read_file": tool_read_file,
+    "grep": tool_grep,
+    "glob": tool_glob,
+}
+
+
+# ============================================================================
+# TOOL SERVER
+# ============================================================================
+
+class ToolServer:
+    """Run-scoped HTTP tool server with a shared, fingerprint-keyed cache."""
+
+    def __init__(self, workspace: Path = WORKSPACE, blackboard=None):
+        self.workspace = workspace
+        self.blackboard = blackboard
+        self.cache: dict[str, str] = {}
+        self.hits = 0
+        self.misses = 0
+        self.lock = threading.Lock()
+        # Separate from self.lock: a rescan must not stall cache lookups of other calls
+        self._fingerprint_lock = threading.Lock()
+        self._fingerprint = ""
+        self._fingerprint_at = 0.0
+        self.httpd: Optional[ThreadingHTTPServer] = None
+        self.thread: Optional[threading.Thread] = None
+        self.config_path: Optional[Path] = None
+
+    @property
+    def url(self) -> str:
+        host, port = self.httpd.server_address[:2]
+        return f"http://{host}:{port}"
+
+    def fingerprint(self) -> str:
+        with self._fingerprint_lock:
+            if time.time() - self._fingerprint_at > FINGERPRINT_TTL:
+                self._fingerprint = workspace_fingerprint(self.workspace)
+                self._fingerprint_at = time.time()
+            return self._fingerprint
+
+    def call(self, tool: str, args: dict) -> tuple[str, bool]:
+        if self.blackboard and tool == "post_finding":
+            self.blackboard.post(args.get("agent") or "agent", args.get("ref", ""), args.get("note", ""))
+            return "posted", False
+        if self.blackboard and tool == "query_findings":
+            return self.blackboard.render(self.blackboard.query(args.get("query"))), False
+
+        fn = TOOLS.get(tool)
+        if not fn:
+            raise ValueError(f"Unknown tool: {tool}")
+        if not _fingerprinted(self.workspace, args.get("path")):
+            # state/, .git etc. change without changing the fingerprint: always read fresh
+            return fn(self.workspace, **args), False
+        key = f"{self.fingerprint()}:{tool}:{json.dumps(args, sort_keys=True)}"
+        with self.lock:
+            if key in self.cache:
+                self.hits += 1
+                return self.cache[key], True
+        result = fn(self.workspace, **args)
+        with self.lock:
+            self.cache[key] = result
+            self.misses += 1
+        return result, False
+
+    def start(self) -> "ToolServer":
+        server = self
+
+        class Handler(BaseHTTPRequestHandler):
+            def do_POST(self):
+                length = int(self.headers.get("Content-Length", 0))
+                try:
+                    body = json.loads(self.rfile.read(length) or b"{}")
+                    result, cached = server.call(body.get("tool", ""), body.get("args") or {})
+                    self._reply(200, {"result": result, "cached": cached})
+                except Exception as e:
+                    self._reply(200, {"error": str(e)})
+
+            def do_GET(self):
+                self._reply(200, {"hits": server.hits, "misses": server.misses, "entries": len(server.cache)})
+
+            def _reply(self, code: int, payload: dict):
+                data = json.dumps(payload).encode("utf-8")
+                self.send_response(code)
+                self.send_header("Content-Type", "application/json")
+                self.send_header("Content-Length", str(len(data)))
+                self.end_headers()
+                self.wfile.write(data)
+
+            def log_message(self, *args):
+                pass
+
+        self.httpd = ThreadingHTTPServer(("127.0.0.1", 0), Handler)
+        self.thread = threading.Thread(target=self.httpd.serve_forever, daemon=True)
+        self.thread.start()
+        self.config_path = self._write_mcp_config()
+        print(f"  {Colors.GRAY}[tools]{Colors.RESET} shared tool server at {self.url}")
+        return self
+
+    def stop(self):
+        if self.httpd:
+            self.httpd.shutdown()
+            self.httpd.server_close()
+            print(f"  {Colors.GRAY}[tools]{Colors.RESET} cache hits={self.hits} misses={self.misses}")
+        if self.config_path and self.config_path.exists():
+            self.config_path.unlink()
+
+    def __enter__(self) -> "ToolServer":
+        return self.start()
+
+    def __exit__(self, *exc):
+        self.stop()
+
+    def _write_mcp_config(self) -> Path:
+        TOOLSERVER_DIR.mkdir(parents=True, exist_ok=True)
+        path = TOOLSERVER_DIR / f"mcp-{self.httpd.server_address[1]}.json"
+        config = {
+            "mcpServers": {
+                SERVER_NAME: {
+                    "command": sys.executable,
+                    "args": [str(Path(__file__).resolve()), "proxy", "--url", self.url],
+                }
+            }
+        }
+        if self.blackboard:
+            config["mcpServers"][SERVER_NAME]["args"].append("--blackboard")
+        path.write_text(json.dumps(config, indent=2))
+        return path
+
+
+# ============================================================================
+# STDIO MCP PROXY
+# ============================================================================
+
+def _forward(url: str, tool: str, args: dict) -> dict:
+    request = urllib.request.Request(
+        url, data=json.dumps({"tool": tool, "args": args}).encode("utf-8"),
+        headers={"Content-Type": "application/json"}, method="POST",
+    )
+    with urllib.request.urlopen(request, timeout=120) as response:
+        return json.loads(response.read())
+
+
+def run_proxy(url: str, blackboard: bool = False):
+    """Minimal MCP stdio server that forwards tool calls to the shared server."""
+    schemas = TOOL_SCHEMAS + (BLACKBOARD_SCHEMAS if blackboard else [])
+    for raw in sys.stdin:
+        raw = raw.strip()
+        if not raw:
+            continue
+        try:
+            msg = json.loads(raw)
+        except ValueError:
+            continue
+        if "id" not in msg:
+            continue
+
+        method = msg.get("method")
+        params = msg.get("params") or {}
+        if method == "initialize":
+            result = {
+                "protocolVersion": params.get("protocolVersion", "2024-11-05"),
+                "capabilities": {"tools": {}},
+                "serverInfo": {"name": SERVER_NAME, "version": "0.1.0"},
+            }
+        elif method == "tools/list":
+            result = {"tools": schemas}
+        elif method == "tools/call":
+            try:
+                reply = _forward(url, params.get("name", ""), params.get("arguments") or {})
+                text = reply.get("result", reply.get("error", ""))
+                result = {"content": [{"type": "text", "text": text}], "isError": "error" in reply}
+            except Exception as e:
+                result = {"content": [{"type": "text", "text": str(e)}], "isError": True}
+        elif method == "ping":
+            result = {}
+        else:
+            response = {"jsonrpc": "2.0", "id": msg["id"],
+                        "error": {"code": -32601, "message": f"Method not found: {method}"}}
+            print(json.dumps(response), flush=True)
+            continue
+
+        print(json.dumps({"jsonrpc": "2.0", "id": msg["id"], "result": result}), flush=True)
+
+
+# ============================================================================
+# CLI
+# ============================================================================
+
+def main():
+    import argparse
+
+    parser = argparse.ArgumentParser(description="Shared read-only tool server")
+    subparsers = parser.add_subparsers(dest="command")
+    proxy_p = subparsers.add_parser("proxy", help="Stdio MCP proxy (launched by agent CLIs)")
+    proxy_p.add_argument("--url", required=True)
+    proxy_p.add_argument("--blackboard", action="store_true", help="Expose blackboard tools")
+
+    args = parser.parse_args()
+
+    if args.command == "proxy":
+        run_proxy(args.url, blackboard=args.blackboard)
+    else:
+        parser.print_help()
+
+
+if __name__ == "__main__":
+    main()
@@ -19,21 +19,54 @@ from datetime import datetime
 from dataclasses import dataclass, field
 from typing import Optional
 from enum import Enum
-
-    try:
-        from .utils import (
-            Colors, WORKSPACE, STATE_DIR,
-            run_cli, extract_score, compact_text, load_project_context,
-            LoopState, load_state, save_state,
-            print_header, print_phase, print_progress,
-        )
-    except ImportError:
-        from utils import (
-            Colors, WORKSPACE, STATE_DIR,
-            run_cli, extract_score, compact_text, load_project_context,
-            LoopState, load_state, save_state,
-            print_header, print_phase, print_progress,
-        )
+from concurrent.futures import ThreadPoolExecutor
+
+try:
+    from .utils import (
+        Colors, WORKSPACE, STATE_DIR,
+        run_cli, extract_score, compact_text, load_project_context,
+        LoopState, load_state, save_state, note_prompt_section,
+        attribute, reattribute, in_current_context,
+        print_header, print_phase, print_progress,
+    )
+except ImportError:
+    from utils import (
+        Colors, WORKSPACE, STATE_DIR,
+        run_cli, extract_score, compact_text, load_project_context,
+        LoopState, load_state, save_state, note_prompt_section,
+        attribute, reattribute, in_current_context,
+        print_header, print_phase, print_progress,
+    )
+
+try:
+    from .fingerprint import code_fingerprint
+except ImportError:
+    from fingerprint import code_fingerprint
+
+try:
+    from .dashboard import prompting
+except ImportError:
+    from dashboard import prompting
+
+try:
+    from .monitor import DriftMonitor, monitor_enabled
+except ImportError:
+    from monitor import DriftMonitor, monitor_enabled
+
+try:
+    from .scheduler import EtaModel, schedule_tickets, ticket_iterations, deadline_arg
+except ImportError:
+    from scheduler import EtaModel, schedule_tickets, ticket_iterations, deadline_arg
+
+try:
+    from .review_policy import ReviewPolicy, review_policy_enabled, diff_snapshot, diff_delta
+except ImportError:
+    from review_policy import ReviewPolicy, review_policy_enabled, diff_snapshot, diff_delta
+
+try:
+    from .spec_index import SpecIndex, SpecMatch, spec_reuse_enabled, template_text, template_tasks
+except ImportError:
+    from spec_index import SpecIndex, SpecMatch, spec_reuse_enabled, template_text, template_tasks
 
 # ============================================================================
 # CONFIGURATION
@@ -42,6 +75,7 @@ from enum import Enum
 SPECS_DIR = WORKSPACE / "specs"
 TICKETS_DIR = WORKSPACE / "tickets"
 STATE_FILE = STATE_DIR / "tracer_state.json"
+CHECKPOINT_OUTPUT_CHARS = 4000
 
 
 # ============================================================================
@@ -79,6 +113,8 @@ class Spec:
     clarifications: list[Clarification] = field(default_factory=list)
     version: int = 1
     status: str = "draft"
+    request: str = ""               # the user's original words, before refinement
+    template: Optional[str] = None  # id of the prior spec this one was adapted from
 
     def to_markdown(self) -> str:
         md = f"# Spec: {self.title}\n\n**ID:** {self.id}\n**Status:** {self.status}\n\n"
@@ -106,6 +142,10 @@ class Ticket:
     progress: int = 0
     deviations: list[dict] = field(default_factory=list)
     iterations: list[dict] = field(default_factory=list)
+    deadline: Optional[str] = None
+    eta_sec: float = 0.0
+    estimated_cost: float = 0.0
+    checkpoint: dict = field(default_factory=dict)
 
 
 # ============================================================================
@@ -130,6 +170,7 @@ class Tracer:
         for f in SPECS_DIR.glob("*.json"):
             try:
                 data = json.loads(f.read_text())
+                data["clarifications"] = [Clarification(**c) for c in data.get("clarifications", [])]
                 self.specs[data["id"]] = Spec(**{
                     k: v for k, v in data.items()
                     if k in Spec.__dataclass_fields__
@@ -157,6 +198,7 @@ class Tracer:
             "clarifications": [{"question": c.question, "answer": c.answer, "category": c.category}
                              for c in spec.clarifications],
             "version": spec.version, "status": spec.status,
+            "request": spec.request, "template": spec.template,
         }
         (SPECS_DIR / f"{spec.id}.json").write_text(json.dumps(data, indent=2))
         (SPECS_DIR / f"{spec.id}.md").write_text(spec.to_markdown())
@@ -169,6 +211,8 @@ class Tracer:
             "description": ticket.description, "status": ticket.status.value,
             "tasks": ticket.tasks, "progress": ticket.progress,
             "deviations": ticket.deviations, "iterations": ticket.iterations,
+            "deadline": ticket.deadline, "eta_sec": ticket.eta_sec,
+            "estimated_cost": ticket.estimated_cost, "checkpoint": ticket.checkpoint,
         }
         (TICKETS_DIR / f"{ticket.id}.json").write_text(json.dumps(data, indent=2))
         self.tickets[ticket.id] = ticket
@@ -176,7 +220,8 @@ class Tracer:
     def _spec_context(self, spec: Spec, include: tuple[str, ...], max_chars: int) -> str:
         spec_file = SPECS_DIR / f"{spec.id}.md"
         if spec_file.exists():
-            doc = load_project_context(spec_file, max_chars=max_chars, story_id=spec.id, story_name=spec.title)
+            doc = load_project_context(spec_file, max_chars=max_chars, story_id=spec.id,
+                                       story_name=spec.title, section_name="spec")
             if doc:
                 return doc
 
@@ -193,7 +238,10 @@ class Tracer:
             parts.append(f"CONSTRAINTS: {spec.constraints}")
         if "out_of_scope" in include:
             parts.append(f"OUT_OF_SCOPE: {spec.out_of_scope}")
-        return compact_text("\n".join(parts), max_chars)
+        text = "\n".join(parts)
+        context = compact_text(text, max_chars)
+        note_prompt_section("spec", context, len(text))
+        return context
 
     # =========================================================================
     # CLARIFICATION PHASE
@@ -204,31 +252,39 @@ class Tracer:
         print_phase("CLARIFY", "Refining your request")
 
         spec_id = f"SPEC-{hashlib.md5(request.encode()).hexdigest()[:8].upper()}"
-        spec = Spec(id=spec_id, title="", description=request)
+        spec = Spec(id=spec_id, title="", description=request, request=request)
 
         self.state.spec_id = spec_id
         save_state(self.state, STATE_FILE)
 
+        template = self._find_template(request)
+        if template and template.duplicate:
+            return self._reuse_spec(spec, template)
+
         # Generate questions
-        questions = self._generate_questions(request)
+        with attribute("spec", spec_id):
+            questions = self._generate_questions(request, template)
         spec.clarifications = questions
 
-        if not questions:
+        if not questions and template is None:
             print(f"  {Colors.GREEN}✓ Request is clear{Colors.RESET}")
             spec.status = "refined"
             self._save_spec(spec)
             return spec
 
-        print(f"\n  {Colors.CYAN}I have {len(questions)} questions:{Colors.RESET}\n")
+        with prompting():
+            if questions:
+                print(f"\n  {Colors.CYAN}I have {len(questions)} questions:{Colors.RESET}\n")
 
-        for i, q in enumerate(questions, 1):
-            print(f"  {Colors.BOLD}{i}.{Colors.RESET} [{q.category.upper()}] {q.question}")
-            answer = input(f"  {Colors.YELLOW}>{Colors.RESET} ").strip()
-            q.answer = answer if answer else "[skipped]"
-            spec.clarifications[i-1] = q
+            for i, q in enumerate(questions, 1):
+                print(f"  {Colors.BOLD}{i}.{Colors.RESET} [{q.category.upper()}] {q.question}")
+                answer = input(f"  {Colors.YELLOW}>{Colors.RESET} ").strip()
+                q.answer = answer if answer else "[skipped]"
+                spec.clarifications[i-1] = q
 
         # Refine spec
-        spec = self._refine_spec(spec)
+        with attribute("spec", spec.id):
+            spec = self._refine_spec(spec, template)
         spec.status = "refined"
         self._save_spec(spec)
 
@@ -238,10 +294,68 @@ class Tracer:
 
         return spec
 
-    def _generate_questions(self, request: str) -> list[Clarification]:
-        """Generate clarifying questions."""
+    def _find_template(self, request: str) -> Optional[SpecMatch]:
+        """Closest prior spec for this request, when spec reuse is on."""
+        if not spec_reuse_enabled():
+            return None
+        match = SpecIndex(self.specs, self.tickets).best(request)
+        if match:
+            kind = "repeat of" if match.duplicate else "similar to"
+            print(f"  {Colors.CYAN}[reuse]{Colors.RESET} {kind} {match.spec.id} "
+                  f"\"{match.spec.title}\" (similarity {match.score:.2f})")
+        return match
+
+    def _reuse_spec(self, spec: Spec, match: SpecMatch) -> Spec:
+        """Same request as a prior spec: copy it instead of asking and refining again."""
+        prior = match.spec
+        spec.title = prior.title
+        spec.description = prior.description
+        spec.requirements = list(prior.requirements)
+        spec.acceptance_criteria = list(prior.acceptance_criteria)
+        spec.constraints = list(prior.constraints)
+        spec.out_of_scope = list(prior.out_of_scope)
+        spec.clarifications = list(prior.clarifications)
+        spec.template = prior.id
+        spec.status = "refined"
+        self._save_spec(spec)
+        print(f"  {Colors.GREEN}✓ Spec reused: {spec.id}{Colors.RESET} (from {prior.id}, no questions needed)")
+        return spec
+
+    def _template_match(self, spec: Spec) -> Optional[SpecMatch]:
+        prior = self.specs.get(spec.template) if spec.template else None
+        if prior is None:
+            return None
+        ticket = next((t for t in self.tickets.values() if t.spec_id == prior.id and t.tasks), None)
+        return SpecMatch(prior, ticket, 1.0)
+
+    def _generate_questions(self, request: str, template: Optional[SpecMatch] = None) -> list[Clarification]:
+        """Generate clarifying questions (only about differences when a template exists)."""
         request_text = compact_text(request, 2000)
-        prompt = f'''
+        note_prompt_section("request", request_text, len(request))
+        if template is not None:
+            prior = compact_text(template_text(template), 3000)
+            note_prompt_section("template", prior)
+            prompt = f'''
+A similar request was specified before. Its spec and task breakdown will be
+reused as a template for this new request.
+
+NEW REQUEST: {request_text}
+
+{prior}
+
+Generate 0-3 clarifying questions ONLY about where the new request differs
+from the prior one or leaves those differences ambiguous. Do not ask about
+anything the prior spec already settles. If nothing needs asking, output [].
+
+Categories: scope, approach, constraints, acceptance
+
+Output JSON array:
+[{{"question": "...", "category": "scope"}}]
+
+Only output the JSON.
+'''
+        else:
+            prompt = f'''
 Given this request, generate 3-4 clarifying questions.
 
 REQUEST: {request_text}
@@ -270,20 +384,37 @@ Only output the JSON.
         except:
             pass
 
+        if template is not None:
+            # The template already answers the generic questions below
+            return []
         return [
             Clarification("What specific files should this affect?", category="scope"),
             Clarification("Any constraints I should know about?", category="constraints"),
             Clarification("How will you verify it works?", category="acceptance"),
         ]
 
-    def _refine_spec(self, spec: Spec) -> Spec:
-        """Refine spec from clarifications."""
-        clarifications = "\n".join([
+    def _refine_spec(self, spec: Spec, template: Optional[SpecMatch] = None) -> Spec:
+        """Refine spec from clarifications (adapting the template spec when given)."""
+        answers = "\n".join([
             f"Q: {c.question}\nA: {c.answer or '[skipped]'}"
             for c in spec.clarifications
         ])
-        clarifications = compact_text(clarifications, 2000)
+        clarifications = compact_text(answers, 2000)
+        note_prompt_section("clarifications", clarifications, len(answers))
         request_text = compact_text(spec.description, 2000)
+        note_prompt_section("request", request_text, len(spec.description))
+
+        adapt = ""
+        if template is not None:
+            prior = compact_text(template_text(template), 3000)
+            note_prompt_section("template", prior)
+            adapt = f"""
+Start from this prior spec for a similar request. Keep everything that still
+applies; change only what the new request or the clarifications change.
+
+{prior}
+"""
+            spec.template = template.spec.id
 
         prompt = f'''
 Create a specification from this request and clarifications.
@@ -291,8 +422,8 @@ Create a specification from this request and clarifications.
 REQUEST: {request_text}
 
         CLARIFICATIONS:
-        {clarifications}
-
+        {clarifications or "(none)"}
+{adapt}
 Output JSON:
 {{"title": "...", "description": "...", "requirements": [...], "acceptance_criteria": [...], "constraints": [...], "out_of_scope": [...]}}
 
@@ -337,32 +468,50 @@ Only output JSON.
             status=TicketStatus.REFINED,
         )
 
-        # Generate tasks
-        spec_context = self._spec_context(spec, ("title", "requirements"), 2000)
-        prompt = f'''
+        # Generate tasks (adapted from the template ticket's breakdown when there is one)
+        template = self._template_match(spec)
+        prior_tasks = template_tasks(template) if template else []
+        if prior_tasks and spec.requirements == template.spec.requirements:
+            ticket.tasks = prior_tasks
+            print(f"  {Colors.CYAN}[reuse]{Colors.RESET} tasks copied from {template.ticket.id}")
+            output = None
+        else:
+            spec_context = self._spec_context(spec, ("title", "requirements"), 2000)
+            prior = ""
+            if prior_tasks:
+                listing = "\n".join(f"- {t['name']} ({t['type']})" for t in prior_tasks)
+                note_prompt_section("template", listing)
+                prior = f"""
+A similar spec ({template.spec.id}) was broken into these tasks. Reuse them,
+adding, removing or renaming only where this spec differs:
+
+{listing}
+"""
+            prompt = f'''
 Break this spec into tasks:
 
 {spec_context}
-
+{prior}
 Output JSON array:
 [{{"name": "Task name", "type": "research|code|test"}}]
 '''
-        output, _ = run_cli(
-            self.cli,
-            prompt,
-            timeout=120,
-            show_output=False,
-            usage_label="tracer:ticket:tasks",
-        )
+            with attribute("spec", spec.id), attribute("ticket", ticket.id):
+                output, _ = run_cli(
+                    self.cli,
+                    prompt,
+                    timeout=120,
+                    show_output=False,
+                    usage_label="tracer:ticket:tasks",
+                )
 
         try:
-            match = re.search(r'\[[\s\S]*\]', output)
+            match = re.search(r'\[[\s\S]*\]', output) if output is not None else None
             if match:
                 tasks = json.loads(match.group())
                 ticket.tasks = [{"name": t["name"], "type": t.get("type", "code"), "done": False}
                                for t in tasks]
         except:
-            ticket.tasks = [
+            ticket.tasks = prior_tasks or [
                 {"name": "Research", "type": "research", "done": False},
                 {"name": "Implement", "type": "code", "done": False},
                 {"name": "Test", "type": "test", "done": False},
@@ -382,8 +531,19 @@ Output JSON array:
     # EXECUTION WITH DEVIATION DETECTION
     # =========================================================================
 
-    def execute(self, ticket: Ticket) -> Ticket:
-        """Execute ticket with deviation detection."""
+    def execute(self, ticket: Ticket, lean: bool = False) -> Ticket:
+        """Execute ticket with deviation detection.
+
+        Progress inside an iteration is checkpointed on the ticket after each
+        phase (implemented → reviewed → corrected), so a resumed ticket picks
+        up at the interrupted phase instead of repeating finished calls.
+        Lean mode skips the review/correct rounds to meet a deadline but still
+        gives every pending task an implementation iteration.
+        """
+        with attribute("spec", ticket.spec_id), attribute("ticket", ticket.id):
+            return self._execute(ticket, lean)
+
+    def _execute(self, ticket: Ticket, lean: bool) -> Ticket:
         print_phase("EXECUTE", f"Working on {ticket.id}")
 
         spec = self.specs.get(ticket.spec_id)
@@ -394,30 +554,86 @@ Output JSON array:
         ticket.status = TicketStatus.IN_PROGRESS
         self._save_ticket(ticket)
 
-        max_iterations = 5
-        for iteration in range(1, max_iterations + 1):
+        policy = ReviewPolicy() if review_policy_enabled() else None
+        skipped_types: list[str] = []
+
+        first = ticket.checkpoint.get("iteration", 1)
+        pending = sum(1 for t in ticket.tasks if not t.get("done"))
+        max_iterations = ticket_iterations(pending, lean)
+        for iteration in range(first, first + max_iterations):
             self.state.iteration = iteration
             save_state(self.state, STATE_FILE)
 
-            print(f"\n  {Colors.CYAN}━━━ Iteration {iteration} ━━━{Colors.RESET}")
+            cp = ticket.checkpoint if ticket.checkpoint.get("iteration") == iteration else {}
+            phase = cp.get("phase", "start")
+            if phase == "start":
+                print(f"\n  {Colors.CYAN}━━━ Iteration {iteration} ━━━{Colors.RESET}")
+            else:
+                print(f"\n  {Colors.CYAN}━━━ Iteration {iteration} (resuming after {phase}) ━━━{Colors.RESET}")
 
-            # Run implementation
-            impl_output = self._run_implementation(spec, ticket)
+            task = next((t for t in ticket.tasks if not t.get("done")), None)
+            task_type = (task or {}).get("type", "code")
+            reattribute("task", (task or {}).get("name", "-"))
 
-            # Check for deviations
-            deviations = self._detect_deviations(spec, impl_output)
+            # Run implementation
+            if phase == "start":
+                before = diff_snapshot() if policy else None
+                impl_output, early_deviation = self._run_implementation(spec, ticket)
+                diff = diff_delta(before, diff_snapshot()) if policy else None
+                self._checkpoint(ticket, iteration, "implemented", task_type=task_type,
+                                 impl_output=impl_output[:CHECKPOINT_OUTPUT_CHARS],
+                                 early_deviation=early_deviation, diff=diff)
+            else:
+                impl_output, early_deviation = cp.get("impl_output", ""), cp.get("early_deviation")
+                task_type = cp.get("task_type", task_type)
+                diff = cp.get("diff")
+
+            # Review and verification are read-only checks of the same state;
+            # a stored review is reused only if the workspace is unchanged since.
+            if phase in ("reviewed", "corrected") and cp.get("snapshot") == code_fingerprint():
+                deviations, all_met, reviewed = cp["deviations"], cp["all_met"], cp["reviewed"]
+            else:
+                if phase in ("reviewed", "corrected"):
+                    print(f"  {Colors.GRAY}Workspace changed since checkpoint; re-reviewing{Colors.RESET}")
+                    phase = "implemented"
+                reviewed = True
+                if early_deviation:
+                    deviations, all_met = [early_deviation], False
+                else:
+                    if lean:
+                        # Deadline mode: verification only, so no correction rounds
+                        reviewed = False
+                    elif policy and diff is not None:
+                        reviewed, reason = policy.decide(task_type, *diff)
+                        print(f"  {Colors.GRAY}[review] {'full review' if reviewed else 'skipped'}: "
+                              f"{reason} ({diff[0]} lines, {diff[1]} files){Colors.RESET}")
+                    deviations, all_met = self._review_and_verify(spec, impl_output, review=reviewed)
+                    if policy and reviewed:
+                        policy.record_review(task_type, bool(deviations))
+                        if deviations:
+                            for skipped in skipped_types:
+                                policy.record_escape(skipped)
+                            skipped_types.clear()
+                    elif policy and not lean:
+                        policy.record_skip(task_type)
+                        skipped_types.append(task_type)
+
+                if deviations:
+                    self.state.deviations_detected += len(deviations)
+                    ticket.deviations.extend(deviations)
+                self._checkpoint(ticket, iteration, "reviewed", deviations=deviations,
+                                 all_met=all_met, reviewed=reviewed)
 
             if deviations:
-                self.state.deviations_detected += len(deviations)
-                ticket.deviations.extend(deviations)
-                self._save_ticket(ticket)
-
                 print(f"\n  {Colors.YELLOW}⚠ {len(deviations)} deviation(s) detected{Colors.RESET}")
 
                 # Try correction
-                if self._correct_deviations(spec, deviations):
+                if phase == "corrected":
+                    print(f"  {Colors.GRAY}Correction already applied{Colors.RESET}")
+                elif self._correct_deviations(spec, deviations):
                     self.state.deviations_corrected += 1
                     print(f"  {Colors.GREEN}✓ Corrected{Colors.RESET}")
+                    self._checkpoint(ticket, iteration, "corrected")
                 else:
                     ticket.status = TicketStatus.BLOCKED
                     self._save_ticket(ticket)
@@ -425,18 +641,21 @@ Output JSON array:
             else:
                 print(f"  {Colors.GREEN}✓ No deviations{Colors.RESET}")
 
-                if self._verify_completion(spec):
+                if all_met:
                     ticket.status = TicketStatus.COMPLETED
                     ticket.progress = 100
                     for t in ticket.tasks:
                         t["done"] = True
+                    ticket.checkpoint = {}
                     self._save_ticket(ticket)
                     print(f"\n  {Colors.GREEN}✓ Complete!{Colors.RESET}")
                     break
 
-            ticket.iterations.append({"num": iteration, "result": "deviation" if deviations else "ok"})
+            ticket.iterations.append({"num": iteration, "result": "deviation" if deviations else "ok",
+                                      "reviewed": reviewed})
             done = sum(1 for t in ticket.tasks if t.get("done"))
             ticket.progress = int((done / len(ticket.tasks)) * 100) if ticket.tasks else 0
+            ticket.checkpoint = {"iteration": iteration + 1, "phase": "start"}
             self._save_ticket(ticket)
 
             print_progress(ticket.progress, 100)
@@ -444,6 +663,41 @@ Output JSON array:
         save_state(self.state, STATE_FILE)
         return ticket
 
+    def _checkpoint(self, ticket: Ticket, iteration: int, phase: str, **data):
+        """Durably record the last finished phase of the current iteration."""
+        if ticket.checkpoint.get("iteration") != iteration:
+            ticket.checkpoint = {}
+        ticket.checkpoint.update(data)
+        ticket.checkpoint.update({
+            "iteration": iteration,
+            "phase": phase,
+            "snapshot": code_fingerprint(),
+            "ts": datetime.now().isoformat(),
+        })
+        self._save_ticket(ticket)
+        save_state(self.state, STATE_FILE)
+
+    def _review_and_verify(self, spec: Spec, impl_output: str,
+                           review: bool = True) -> tuple[list[dict], bool]:
+        """Run deviation review and completion verification concurrently.
+
+        A detected deviation always overrides "all_met": the verify result is
+        only trusted when the review came back clean. With review=False (the
+        risk policy skipped it) only verification runs.
+        """
+        if not review:
+            return [], self._verify_completion(spec)
+
+        with ThreadPoolExecutor(max_workers=2) as executor:
+            review_job = executor.submit(in_current_context(self._detect_deviations), spec, impl_output)
+            verify_job = executor.submit(in_current_context(self._verify_completion), spec)
+            deviations = review_job.result()
+            all_met = verify_job.result()
+
+        if deviations:
+            return deviations, False
+        return deviations, all_met
+
     def _stream_updates(self, label: str):
         """Stream live updates during execution."""
         def _on_line(line: str):
@@ -455,11 +709,11 @@ Output JSON array:
             print(f"  {Colors.GRAY}[{label}]{Colors.RESET} {display}")
         return _on_line
 
-    def _run_implementation(self, spec: Spec, ticket: Ticket) -> str:
-        """Run implementation."""
+    def _run_implementation(self, spec: Spec, ticket: Ticket) -> tuple[str, Optional[dict]]:
+        """Run implementation; returns output and a deviation if the monitor aborted it."""
         pending = [t for t in ticket.tasks if not t.get("done")]
         if not pending:
-            return ""
+            return "", None
 
         task = pending[0]
         spec_context = self._spec_context(spec, ("title", "requirements", "acceptance"), 3000)
@@ -473,20 +727,34 @@ TASK: {task["name"]}
         Follow the spec exactly. Do not add unrequested features.
         '''
         print(f"  {Colors.GRAY}Task: {task['name']}{Colors.RESET}")
+        on_line = self._stream_updates("IMPLEMENT")
+        monitor = None
+        if monitor_enabled():
+            monitor = DriftMonitor(self.cli, spec.out_of_scope, spec.constraints, task_name=task["name"])
+            if monitor.active:
+                on_line = monitor.wrap(on_line)
+            else:
+                monitor = None
+
         output, code = run_cli(
             self.cli,
             prompt,
             timeout=600,
-            on_line=self._stream_updates("IMPLEMENT"),
+            on_line=on_line,
             show_output=False,
             usage_label="tracer:execute:implement",
+            abort_check=monitor.check if monitor else None,
         )
 
+        if monitor and monitor.deviation:
+            print(f"  {Colors.YELLOW}⚠ Implementer aborted early by monitor{Colors.RESET}")
+            return output, monitor.deviation
+
         if code == 0:
             task["done"] = True
             self._save_ticket(ticket)
 
-        return output
+        return output, None
 
     def _detect_deviations(self, spec: Spec, output: str) -> list[dict]:
         """Detect deviations from spec."""
@@ -551,7 +819,9 @@ CORRECTIONS: {corrections}
 
     def _verify_completion(self, spec: Spec) -> bool:
         """Verify acceptance criteria are met."""
-        acceptance = compact_text("\n".join(spec.acceptance_criteria), 1500)
+        criteria = "\n".join(spec.acceptance_criteria)
+        acceptance = compact_text(criteria, 1500)
+        note_prompt_section("acceptance", acceptance, len(criteria))
         prompt = f'''
 Verify all acceptance criteria are met:
 
@@ -581,7 +851,7 @@ Verify all acceptance criteria are met:
     # MAIN WORKFLOW
     # =========================================================================
 
-    def _run_flow(self, request: str, auto_confirm: bool):
+    def _run_flow(self, request: str, auto_confirm: bool, deadline: Optional[str] = None):
         """Run full Tracer workflow."""
         print_header("TRAYCER", "Refine → Spec → Execute → Verify")
 
@@ -593,16 +863,20 @@ Verify all acceptance criteria are met:
 
         # Confirm
         if not auto_confirm:
-            print(f"\n  {Colors.YELLOW}Create ticket and execute? [Y/n]{Colors.RESET}")
-            if input("  > ").strip().lower() in ['n', 'no']:
+            with prompting():
+                print(f"\n  {Colors.YELLOW}Create ticket and execute? [Y/n]{Colors.RESET}")
+                answer = input("  > ").strip().lower()
+            if answer in ['n', 'no']:
                 print(f"  {Colors.GRAY}Stopped. Spec saved.{Colors.RESET}")
                 return
 
         # Create ticket
         ticket = self.create_ticket(spec)
+        ticket.deadline = deadline
+        entry = self._plan_deadline(ticket)
 
         # Execute
-        ticket = self.execute(ticket)
+        ticket = self.execute(ticket, lean=entry.lean)
 
         # Summary
         color = Colors.GREEN if ticket.status == TicketStatus.COMPLETED else Colors.YELLOW
@@ -615,13 +889,63 @@ Verify all acceptance criteria are met:
         print(f"  Progress: {ticket.progress}%")
         print(f"{color}{'═' * 50}{Colors.RESET}")
 
-    def start(self, request: str):
+    def start(self, request: str, deadline: Optional[str] = None):
         """Run full Tracer workflow with confirmation."""
-        self._run_flow(request, auto_confirm=False)
+        self._run_flow(request, auto_confirm=False, deadline=deadline)
 
-    def run_all(self, request: str):
+    def run_all(self, request: str, deadline: Optional[str] = None):
         """Run full Tracer workflow without confirmation."""
-        self._run_flow(request, auto_confirm=True)
+        self._run_flow(request, auto_confirm=True, deadline=deadline)
+
+    # =========================================================================
+    # DEADLINE SCHEDULING
+    # =========================================================================
+
+    def _plan_deadline(self, ticket: Ticket):
+        """Estimate a ticket's ETA and cost; warn when its deadline is infeasible."""
+        entry = schedule_tickets([ticket], EtaModel())[0]
+        ticket.eta_sec = round(entry.eta_sec, 1)
+        ticket.estimated_cost = round(entry.cost_usd, 4)
+        self._save_ticket(ticket)
+
+        if ticket.deadline:
+            print(f"  {Colors.GRAY}ETA ≈{entry.eta_sec / 60:.0f}m, cost ≈${entry.cost_usd:.2f}, "
+                  f"deadline {ticket.deadline}{Colors.RESET}")
+            if entry.lean:
+                print(f"  {Colors.YELLOW}⚠ Tight deadline: limiting review/correct rounds{Colors.RESET}")
+            if not entry.feasible:
+                print(f"  {Colors.YELLOW}⚠ Deadline likely infeasible (finishes ≈{entry.finish_at:%H:%M}){Colors.RESET}")
+        return entry
+
+    def schedule(self, run: bool = False, strict: bool = False):
+        """Show (and optionally run) open tickets in earliest-deadline-first order."""
+        open_tickets = [t for t in self.tickets.values() if t.status != TicketStatus.COMPLETED]
+        entries = schedule_tickets(open_tickets, EtaModel(), strict=strict)
+
+        print()
+        print(f"{Colors.CYAN}═══ Tracer Schedule (EDF) ═══{Colors.RESET}")
+        print()
+        if not entries:
+            print(f"  {Colors.GRAY}No open tickets{Colors.RESET}\n")
+            return
+        for e in entries:
+            if not e.admitted:
+                flag = f"{Colors.RED}deferred{Colors.RESET}"
+            elif not e.feasible:
+                flag = f"{Colors.YELLOW}at risk{Colors.RESET}"
+            else:
+                flag = f"{Colors.GREEN}ok{Colors.RESET}"
+            mode = "lean" if e.lean else "full"
+            print(f"  {e.ticket_id:<16} due {e.deadline or '—':<20} eta {e.eta_sec / 60:6.0f}m  "
+                  f"${e.cost_usd:6.2f}  done ≈{e.finish_at:%m-%d %H:%M}  {mode:<4}  {flag}")
+        print()
+
+        if not run:
+            return
+        for e in entries:
+            if not e.admitted:
+                continue
+            self.execute(self.tickets[e.ticket_id], lean=e.lean)
 
     def print_status(self):
         """Print status."""
@@ -646,6 +970,26 @@ Verify all acceptance criteria are met:
                 print(f"    {icon} {tid}: {t.title[:40]}")
         print()
 
+    def print_similar(self, request: str, limit: int = 5):
+        """Show prior specs a request would be matched against for reuse."""
+        index = SpecIndex(self.specs, self.tickets)
+        best = index.best(request)
+        print()
+        print(f"{Colors.CYAN}═══ Similar Specs ({len(index.entries)} indexed) ═══{Colors.RESET}")
+        print()
+        matches = index.search(request, limit)
+        if not matches:
+            print(f"  {Colors.GRAY}No similar specs{Colors.RESET}\n")
+            return
+        for m in matches:
+            mark = "★" if best is not None and m.spec.id == best.spec.id else " "
+            tasks = f"{len(m.ticket.tasks)} tasks" if m.ticket else "no ticket"
+            flag = "  repeat" if m.duplicate else ""
+            print(f"  {mark} {m.score:.2f}  {m.spec.id}  {m.spec.title[:40]:<40}  {tasks}{flag}")
+        if best is None:
+            print(f"\n  {Colors.GRAY}Nothing above the reuse threshold; clarification would start fresh{Colors.RESET}")
+        print()
+
 
 # ============================================================================
 # CLI
@@ -660,12 +1004,19 @@ def main():
     subparsers = parser.add_subparsers(dest="command")
     start_p = subparsers.add_parser("start")
     start_p.add_argument("request", nargs="?")
+    start_p.add_argument("--deadline", type=deadline_arg, help="Duration (90m, 2h, 1d) or ISO timestamp")
     run_p = subparsers.add_parser("run")
     run_p.add_argument("request", nargs="?")
+    run_p.add_argument("--deadline", type=deadline_arg, help="Duration (90m, 2h, 1d) or ISO timestamp")
     subparsers.add_parser("status")
     resume_p = subparsers.add_parser("resume")
     resume_p.add_argument("ticket_id")
     subparsers.add_parser("list")
+    similar_p = subparsers.add_parser("similar")
+    similar_p.add_argument("request")
+    schedule_p = subparsers.add_parser("schedule")
+    schedule_p.add_argument("--run", action="store_true", help="Execute tickets in EDF order")
+    schedule_p.add_argument("--strict", action="store_true", help="Defer tickets that cannot meet their deadline")
 
     args = parser.parse_args()
 
@@ -674,21 +1025,23 @@ def main():
     signal.signal(signal.SIGINT, lambda s, f: (print(f"\n{Colors.YELLOW}Interrupted.{Colors.RESET}"), sys.exit(130)))
 
     if args.command == "start":
+        deadline = args.deadline
         if args.request:
-            tracer.start(args.request)
+            tracer.start(args.request, deadline=deadline)
         else:
             print(f"\n{Colors.CYAN}What would you like to accomplish?{Colors.RESET}")
             request = input(f"{Colors.YELLOW}> {Colors.RESET}")
             if request.strip():
-                tracer.start(request)
+                tracer.start(request, deadline=deadline)
     elif args.command == "run":
+        deadline = args.deadline
         if args.request:
-            tracer.run_all(args.request)
+            tracer.run_all(args.request, deadline=deadline)
         else:
             print(f"\n{Colors.CYAN}What would you like to accomplish?{Colors.RESET}")
             request = input(f"{Colors.YELLOW}> {Colors.RESET}")
             if request.strip():
-                tracer.run_all(request)
+                tracer.run_all(request, deadline=deadline)
 
     elif args.command == "status":
         tracer.print_status()
@@ -700,6 +1053,12 @@ def main():
         else:
             print(f"{Colors.RED}Ticket not found{Colors.RESET}")
 
+    elif args.command == "schedule":
+        tracer.schedule(run=args.run, strict=args.strict)
+
+    elif args.command == "similar":
+        tracer.print_similar(args.request)
+
     elif args.command == "list":
         print(f"\n{Colors.CYAN}Specs:{Colors.RESET}")
         for s in tracer.specs.values():
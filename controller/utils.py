@@ -11,15 +11,20 @@ Consolidates common code used across all controllers:
 from __future__ import annotations
 
 import os
+import sys
 import subprocess
 import json
 import re
 import time
 import hashlib
+import itertools
+import threading
+import contextvars
+from contextlib import contextmanager
 from pathlib import Path
 from datetime import datetime
 from dataclasses import dataclass, field
-from typing import Optional, Callable
+from typing import Optional, Callable, Iterator
 from enum import Enum
 
 
@@ -57,6 +62,12 @@ CLAUDE_DIR = WORKSPACE / ".claude"
 COMMANDS_DIR = CLAUDE_DIR / "commands"
 AGENTS_DIR = CLAUDE_DIR / "agents"
 USAGE_LOG = STATE_DIR / "usage.jsonl"
+# Evaluation replays log here instead, so they never skew ETAs, simulations or cost reports
+EVAL_USAGE_LOG = STATE_DIR / "eval_usage.jsonl"
+TRACE_LOG = STATE_DIR / "trace.jsonl"
+PROMPT_PROFILE_LOG = STATE_DIR / "prompt_profile.jsonl"
+EVAL_CORPUS = STATE_DIR / "eval_corpus.jsonl"
+CONTEXT_POINTERS = STATE_DIR / "context_pointers.json"
 CACHE_DIR = STATE_DIR / "cache"
 
 
@@ -87,6 +98,11 @@ CLI_CONFIGS = {
     "claude": {
         "cmd": "claude",
         "args": ["--print", "--dangerously-skip-permissions"],
+        "stream_args": ["--output-format", "stream-json", "--verbose"],
+        "mcp_flag": "--mcp-config",
+        # No "model" key, so routing never adds --model; only explicit models
+        # (eval candidates such as claude:haiku) are passed through
+        "model_flag": "--model",
         "prompt_flag": "-p",
     },
     "copilot": {
@@ -97,6 +113,19 @@ CLI_CONFIGS = {
         "cheap_model": "gpt-5.1-codex-mini",
         "prompt_flag": "--prompt",
     },
+    # Local deterministic CLI for stress tests (controller/stub_cli.py)
+    "stub": {
+        "cmd": sys.executable,
+        "args": [str(Path(__file__).resolve().parent / "stub_cli.py")],
+        "prompt_flag": "-p",
+    },
+}
+
+# USD per 1M tokens (input, output); override with ORCHESTRATOR_PRICES="model=in/out,..."
+MODEL_PRICES = {
+    "default": (3.00, 15.00),
+    "gpt-5.2-codex": (1.75, 14.00),
+    "gpt-5.1-codex-mini": (0.25, 2.00),
 }
 
 DEFAULT_CHEAP_LABELS = (
@@ -105,6 +134,7 @@ DEFAULT_CHEAP_LABELS = (
     "tracer:clarify",
     "tracer:ticket",
     "tracer:execute:review",
+    "tracer:execute:monitor",
     "orch:locator",
 )
 
@@ -113,6 +143,51 @@ DEFAULT_CHEAP_LABELS = (
 # CLI EXECUTION
 # ============================================================================
 
+# Callbacks receiving run_cli lifecycle events ("start", "line", "end") and
+# scheduler events ("queue"); each event is a dict with "type" and "ts"
+CLI_LISTENERS: list[Callable[[dict], None]] = []
+_call_ids = itertools.count(1)
+
+
+# Work the current call serves, outermost first ("spec=SPEC-1", "ticket=TKT-1",
+# "task=..."); stamped on usage records for the cost attribution report
+_ATTRIBUTION: contextvars.ContextVar[tuple[str, ...]] = contextvars.ContextVar("attribution", default=())
+
+
+@contextmanager
+def attribute(kind: str, value) -> Iterator[None]:
+    """Attribute run_cli calls in this block to `kind=value` under the current path."""
+    token = _ATTRIBUTION.set(_ATTRIBUTION.get() + (f"{kind}={value}",))
+    try:
+        yield
+    finally:
+        _ATTRIBUTION.reset(token)
+
+
+def reattribute(kind: str, value):
+    """Replace (or add) the `kind` node of the current path, e.g. per loop iteration
+    inside an attribute() block, which restores the outer path on exit."""
+    path = tuple(n for n in _ATTRIBUTION.get() if not n.startswith(f"{kind}="))
+    _ATTRIBUTION.set(path + (f"{kind}={value}",))
+
+
+def in_current_context(fn: Callable) -> Callable:
+    """Wrap fn so worker threads see the submitting thread's attribution."""
+    ctx = contextvars.copy_context()
+    return lambda *args, **kwargs: ctx.copy().run(fn, *args, **kwargs)
+
+
+def emit_event(kind: str, **data):
+    if not CLI_LISTENERS:
+        return
+    event = {"type": kind, "ts": time.time(), **data}
+    for listener in list(CLI_LISTENERS):
+        try:
+            listener(event)
+        except Exception:
+            pass
+
+
 def run_cli(
     cli: str,
     prompt: str,
@@ -122,6 +197,9 @@ def run_cli(
     show_output: bool = True,
     usage_label: Optional[str] = None,
     cache_key: Optional[str] = None,
+    abort_check: Optional[Callable[[], Optional[str]]] = None,
+    mcp_config: Optional[Path] = None,
+    model: Optional[str] = None,
 ) -> tuple[str, int]:
     """
     Execute CLI with streaming output.
@@ -135,6 +213,9 @@ def run_cli(
         show_output: Whether to print output lines
         usage_label: Label for usage tracking output/logs
         cache_key: Optional cache key; if provided, caches output for reuse
+        abort_check: Polled after each output line; returning a reason kills the run
+        mcp_config: Optional MCP server config (e.g. the shared tool server)
+        model: Force a model instead of label-based routing (evaluation replays)
 
     Returns:
         Tuple of (output_text, return_code)
@@ -144,25 +225,48 @@ def run_cli(
         return f"[ERROR] Unknown CLI: {cli}", -1
 
     usage_label = usage_label or "cli"
-    model = _select_model(config, usage_label)
+    model = model or _select_model(config, usage_label)
     cache_key = cache_key or _default_cache_key(prompt, model, usage_label)
 
     cached = _load_cache(cache_key)
+    _log_prompt_profile(usage_label, model, prompt, cached is not None)
     if cached is not None:
-        _log_usage(f"{usage_label}:cache", cli, model, _estimate_tokens(prompt), _estimate_tokens(cached), 0.0)
+        # Entries stay immutable; hits are counted from these records (cache bundles)
+        _log_usage(f"{usage_label}:cache", cli, model, _estimate_tokens(prompt), _estimate_tokens(cached), 0.0,
+                   extra={"cache_key": cache_key})
         print_usage(f"{usage_label}:cache", model, _estimate_tokens(prompt), _estimate_tokens(cached))
         return cached, 0
 
+    tracer = None
     cmd = [config["cmd"]] + config["args"]
+    if "stream_args" in config and tool_tracing_enabled():
+        cmd.extend(config["stream_args"])
+        tracer = ToolCallTracer(usage_label, cli)
+    if "mcp_flag" in config and mcp_config:
+        cmd.extend([config["mcp_flag"], str(mcp_config)])
     if "model_flag" in config and model:
         cmd.extend([config["model_flag"], model])
     cmd.extend([config["prompt_flag"], prompt])
 
     output_lines = []
     start_time = time.time()
+    call_id = next(_call_ids)
+
+    def _emit(raw: str):
+        lines = tracer.feed(raw) if tracer else [raw.rstrip("\n")]
+        for line in lines:
+            output_lines.append(line + "\n")
+            emit_event("line", id=call_id, line=line)
+            if on_line:
+                if line.strip():
+                    on_line(line.rstrip())
+            elif show_output:
+                display = line.rstrip()[:100]
+                print(f"  {Colors.GRAY}│{Colors.RESET} {display}")
 
+    prompt_tokens = _estimate_tokens(prompt)
+    emit_event("start", id=call_id, label=usage_label, model=model, cli=cli, in_tokens=prompt_tokens)
     try:
-        prompt_tokens = _estimate_tokens(prompt)
         process = subprocess.Popen(
             cmd,
             cwd=str(workspace),
@@ -176,41 +280,415 @@ def run_cli(
             elapsed = time.time() - start_time
             if elapsed > timeout:
                 process.kill()
-                _log_usage(usage_label, cli, model, prompt_tokens, 0, elapsed)
+                _log_usage(usage_label, cli, model, prompt_tokens, 0, elapsed,
+                           extra=_usage_extra(tracer, _reap(process, block=True)))
+                emit_event("end", id=call_id, code=-1, status="timeout")
                 return "[TIMEOUT]", -1
 
             line = process.stdout.readline()
             if line:
-                output_lines.append(line)
-                if on_line:
-                    on_line(line.rstrip())
-                elif show_output:
-                    display = line.rstrip()[:100]
-                    print(f"  {Colors.GRAY}│{Colors.RESET} {display}")
-            elif process.poll() is not None:
-                break
+                _emit(line)
+                if abort_check:
+                    reason = abort_check()
+                    if reason:
+                        process.kill()
+                        output_tokens = _estimate_tokens(''.join(output_lines))
+                        _log_usage(f"{usage_label}:aborted", cli, model, prompt_tokens, output_tokens,
+                                   time.time() - start_time, extra=_usage_extra(tracer, _reap(process, block=True)))
+                        emit_event("end", id=call_id, code=-1, status="aborted")
+                        return f"[ABORTED] {reason}\n{''.join(output_lines)}", -1
+            else:
+                # Reap via wait4 (not poll) so the child's resource usage is not lost
+                rusage = _reap(process)
+                if rusage is not None:
+                    break
 
         remaining = process.stdout.read()
-        if remaining:
-            output_lines.append(remaining)
-            if on_line:
-                for line in remaining.split('\n'):
-                    if line.strip():
-                        on_line(line)
+        for line in remaining.splitlines():
+            _emit(line)
 
         output_text = ''.join(output_lines)
+        if tracer and tracer.final_text is not None:
+            output_text = tracer.final_text
         output_tokens = _estimate_tokens(output_text)
-        _save_cache(cache_key, output_text)
-        _log_usage(usage_label, cli, model, prompt_tokens, output_tokens, time.time() - start_time)
+        _save_cache(cache_key, output_text, label=usage_label)
+        _log_usage(usage_label, cli, model, prompt_tokens, output_tokens, time.time() - start_time,
+                   extra=_usage_extra(tracer, rusage))
         print_usage(usage_label, model, prompt_tokens, output_tokens)
+        if process.returncode == 0:
+            _record_eval_sample(usage_label, cli, model, prompt, output_text, time.time() - start_time)
+        emit_event("end", id=call_id, code=process.returncode, status="done", out_tokens=output_tokens)
         return output_text, process.returncode
 
     except FileNotFoundError:
+        emit_event("end", id=call_id, code=-1, status="error")
         return f"[ERROR] CLI '{cli}' not found", -1
     except Exception as e:
+        emit_event("end", id=call_id, code=-1, status="error")
         return f"[ERROR] {e}", -1
 
 
+# ============================================================================
+# CHILD RESOURCE USAGE
+# ============================================================================
+
+# CPU time at or above this share of wall time: the agent waits on local work, not the model
+LOCAL_BOUND_CPU_SHARE = 0.5
+
+
+def _rusage_fields(ru) -> dict:
+    # ru_maxrss is KiB on Linux and bytes on macOS
+    max_rss_kb = ru.ru_maxrss // 1024 if sys.platform == "darwin" else ru.ru_maxrss
+    return {
+        "cpu_user_sec": round(ru.ru_utime, 3),
+        "cpu_sys_sec": round(ru.ru_stime, 3),
+        "max_rss_kb": int(max_rss_kb),
+        "blk_in": ru.ru_inblock,
+        "blk_out": ru.ru_oublock,
+    }
+
+
+def _reap(process: subprocess.Popen, block: bool = False) -> Optional[dict]:
+    """
+    Reap a finished CLI process with wait4 and return its resource usage,
+    which includes every descendant it waited for (tool subprocesses, builds).
+    None while the process is still running; {} when usage is unavailable.
+    """
+    if process.returncode is not None:
+        return {}
+    if not hasattr(os, "wait4"):
+        code = process.wait() if block else process.poll()
+        return None if code is None else {}
+    try:
+        pid, status, ru = os.wait4(process.pid, 0 if block else os.WNOHANG)
+    except ChildProcessError:
+        # Reaped elsewhere; Popen records the exit without usage
+        process.wait()
+        return {}
+    if pid == 0:
+        return None
+    process.returncode = os.waitstatus_to_exitcode(status)
+    return _rusage_fields(ru)
+
+
+def _usage_extra(tracer: Optional[ToolCallTracer], rusage: Optional[dict]) -> Optional[dict]:
+    extra = {**(tracer.summary() if tracer else {}), **(rusage or {})}
+    return extra or None
+
+
+def print_rusage_report(limit: int = 20, days: Optional[int] = None):
+    """Per-label local resource usage and whether agents are local- or model-bound."""
+    cutoff = datetime.now().timestamp() - days * 86400 if days else None
+    by_label: dict[str, dict] = {}
+    for r in load_usage_records():
+        if "cpu_user_sec" not in r:
+            continue
+        if cutoff is not None:
+            try:
+                if datetime.fromisoformat(r.get("ts", "")).timestamp() < cutoff:
+                    continue
+            except ValueError:
+                continue
+        agg = by_label.setdefault(r.get("label", "?"), {
+            "calls": 0, "wall": 0.0, "cpu": 0.0, "rss": 0, "blk_in": 0, "blk_out": 0})
+        agg["calls"] += 1
+        agg["wall"] += r.get("elapsed_sec", 0.0)
+        agg["cpu"] += r.get("cpu_user_sec", 0.0) + r.get("cpu_sys_sec", 0.0)
+        agg["rss"] = max(agg["rss"], r.get("max_rss_kb", 0))
+        agg["blk_in"] += r.get("blk_in", 0)
+        agg["blk_out"] += r.get("blk_out", 0)
+
+    if not by_label:
+        print(f"  {Colors.GRAY}No resource usage recorded yet (needs os.wait4, i.e. Linux/macOS){Colors.RESET}")
+        return
+
+    print(f"\n  {'label':<32} {'calls':>5} {'wall':>8} {'cpu':>8} {'cpu/wall':>8} "
+          f"{'peak RSS':>9} {'blk in':>8} {'blk out':>8}  bound")
+    for label, agg in sorted(by_label.items(), key=lambda kv: -kv[1]["cpu"])[:limit]:
+        share = agg["cpu"] / agg["wall"] if agg["wall"] else 0.0
+        bound = f"{Colors.YELLOW}local{Colors.RESET}" if share >= LOCAL_BOUND_CPU_SHARE else "model"
+        print(f"  {label:<32} {agg['calls']:>5} {agg['wall']:>7.0f}s {agg['cpu']:>7.1f}s {share:>8.0%} "
+              f"{agg['rss'] / 1024:>7.0f}MB {agg['blk_in']:>8} {agg['blk_out']:>8}  {bound}")
+    print(f"\n  {Colors.GRAY}cpu = user + sys of the CLI and the subprocesses it waited for; "
+          f"blocks are filesystem I/O operations{Colors.RESET}")
+    print()
+
+
+# ============================================================================
+# TOOL-CALL TRACING
+# ============================================================================
+
+def tool_tracing_enabled() -> bool:
+    return os.getenv("ORCHESTRATOR_TRACE_TOOLS") == "1"
+
+
+def _tool_args_preview(name: str, args: dict) -> str:
+    for key in ("command", "pattern", "file_path", "path", "url", "query"):
+        if key in args:
+            return f"{key}={str(args[key])[:80]}"
+    return json.dumps(args, sort_keys=True)[:80]
+
+
+class ToolCallTracer:
+    """
+    Parses a CLI's stream-json events into display text and tool-call spans.
+
+    Lines that are not JSON events pass through unchanged, so CLIs without
+    a structured stream still work.
+    """
+
+    def __init__(self, usage_label: str, cli: str):
+        self.usage_label = usage_label
+        self.cli = cli
+        self.pending: dict[str, dict] = {}
+        self.spans: list[dict] = []
+        self.final_text: Optional[str] = None
+
+    def feed(self, raw: str) -> list[str]:
+        raw = raw.strip()
+        if not raw.startswith("{"):
+            return [raw] if raw else []
+        try:
+            event = json.loads(raw)
+        except ValueError:
+            return [raw]
+
+        kind = event.get("type")
+        if kind == "result":
+            self.final_text = event.get("result") or ""
+            return []
+
+        content = (event.get("message") or {}).get("content") or []
+        if not isinstance(content, list):
+            return []
+
+        lines = []
+        for block in content:
+            block_type = block.get("type")
+            if block_type == "text":
+                lines.extend(block.get("text", "").splitlines())
+            elif block_type == "tool_use":
+                lines.append(self._start(block))
+            elif block_type == "tool_result":
+                self._finish(block)
+        return lines
+
+    def _start(self, block: dict) -> str:
+        name = block.get("name", "?")
+        args = block.get("input") or {}
+        digest = hashlib.sha256(json.dumps(args, sort_keys=True).encode("utf-8")).hexdigest()[:12]
+        preview = _tool_args_preview(name, args)
+        self.pending[block.get("id", "")] = {
+            "tool": name, "args_digest": digest, "args_preview": preview, "start": time.time(),
+            # Untruncated, so file reads can be matched exactly (pointer read rates)
+            "args_path": args.get("file_path") or args.get("path"),
+        }
+        return f"→ {name}({preview})"
+
+    def _finish(self, block: dict):
+        call = self.pending.pop(block.get("tool_use_id", ""), None)
+        if not call:
+            return
+        content = block.get("content")
+        size = len(content if isinstance(content, str) else json.dumps(content or ""))
+        span = {
+            "ts": datetime.now().isoformat(),
+            "label": self.usage_label,
+            "cli": self.cli,
+            "tool": call["tool"],
+            "args_digest": call["args_digest"],
+            "args_preview": call["args_preview"],
+            "duration_sec": round(time.time() - call["start"], 3),
+            "output_bytes": size,
+            "error": bool(block.get("is_error")),
+        }
+        if isinstance(call["args_path"], str):
+            span["args_path"] = call["args_path"]
+        self.spans.append(span)
+        _log_trace(span)
+
+    def summary(self) -> dict:
+        return {
+            "tool_calls": len(self.spans),
+            "tool_sec": round(sum(s["duration_sec"] for s in self.spans), 3),
+        }
+
+
+def _log_trace(span: dict):
+    try:
+        TRACE_LOG.parent.mkdir(parents=True, exist_ok=True)
+        with TRACE_LOG.open("a", encoding="utf-8") as f:
+            f.write(json.dumps(span) + "\n")
+    except Exception as e:
+        print(f"  {Colors.YELLOW}[trace]{Colors.RESET} log write failed: {e}")
+
+
+def print_trace_report(limit: int = 10):
+    """Summarize tool-call spans: slowest tools per label and repeated calls."""
+    if not TRACE_LOG.exists():
+        print(f"  {Colors.GRAY}No tool traces yet (set ORCHESTRATOR_TRACE_TOOLS=1){Colors.RESET}")
+        return
+
+    by_tool: dict[tuple[str, str], dict] = {}
+    by_call: dict[tuple[str, str], dict] = {}
+    for line in TRACE_LOG.read_text().splitlines():
+        try:
+            span = json.loads(line)
+        except ValueError:
+            continue
+        key = (span.get("label", "?"), span.get("tool", "?"))
+        agg = by_tool.setdefault(key, {"count": 0, "sec": 0.0, "bytes": 0})
+        agg["count"] += 1
+        agg["sec"] += span.get("duration_sec", 0.0)
+        agg["bytes"] += span.get("output_bytes", 0)
+        call_key = (span.get("tool", "?"), span.get("args_digest", ""))
+        call = by_call.setdefault(call_key, {"count": 0, "sec": 0.0, "preview": span.get("args_preview", "")})
+        call["count"] += 1
+        call["sec"] += span.get("duration_sec", 0.0)
+
+    print(f"\n  {Colors.CYAN}Slowest tools by label:{Colors.RESET}")
+    for (label, tool), agg in sorted(by_tool.items(), key=lambda kv: -kv[1]["sec"])[:limit]:
+        print(f"    {label:<32} {tool:<12} calls={agg['count']:<5} {agg['sec']:8.1f}s  {agg['bytes']:>10}B")
+
+    repeated = [(k, v) for k, v in by_call.items() if v["count"] > 1]
+    print(f"\n  {Colors.CYAN}Repeated calls (same tool + args):{Colors.RESET}")
+    if not repeated:
+        print(f"    {Colors.GRAY}none{Colors.RESET}")
+    for (tool, _), call in sorted(repeated, key=lambda kv: -kv[1]["sec"])[:limit]:
+        print(f"    {tool:<12} x{call['count']:<4} {call['sec']:8.1f}s  {call['preview']}")
+    print()
+
+
+# ============================================================================
+# PROMPT PROFILING
+# ============================================================================
+
+# Sections noted by the context loaders since the last run_cli in this context
+_PROMPT_SECTIONS: contextvars.ContextVar[Optional[list]] = contextvars.ContextVar("prompt_sections", default=None)
+PROFILE_PROBE_CHARS = 200
+
+
+def prompt_profiling_enabled() -> bool:
+    return os.getenv("ORCHESTRATOR_PROMPT_PROFILE") == "1"
+
+
+def note_prompt_section(name: str, text: str, original_chars: Optional[int] = None):
+    """Record a context section about to be placed in the next prompt."""
+    if not prompt_profiling_enabled() or not text:
+        return
+    sections = _PROMPT_SECTIONS.get()
+    if sections is None:
+        sections = []
+        _PROMPT_SECTIONS.set(sections)
+    sections.append({"name": name, "text": text,
+                     "original_chars": len(text) if original_chars is None else original_chars})
+
+
+def _log_prompt_profile(usage_label: str, model: Optional[str], prompt: str, cached: bool):
+    sections = _PROMPT_SECTIONS.get()
+    _PROMPT_SECTIONS.set(None)
+    if not prompt_profiling_enabled():
+        return
+
+    rows = []
+    placed = 0
+    for sec in sections or []:
+        text = sec["text"]
+        probe = text[:PROFILE_PROBE_CHARS].strip()
+        # How often the section actually landed in the prompt (0 = built but dropped)
+        occurrences = prompt.count(probe) if len(probe) >= 40 else 1
+        chars = len(text) * occurrences
+        placed += chars
+        rows.append({
+            "name": sec["name"],
+            "chars": chars,
+            "tokens": _estimate_tokens(text) * occurrences,
+            "bytes": len(text.encode("utf-8")) * occurrences,
+            "original_chars": sec["original_chars"],
+            "truncated_chars": max(0, sec["original_chars"] - len(text)),
+            "occurrences": occurrences,
+        })
+    record = {
+        "ts": datetime.now().isoformat(),
+        "label": usage_label,
+        "model": model,
+        "cached": cached,
+        "prompt_chars": len(prompt),
+        "prompt_tokens": _estimate_tokens(prompt),
+        "template_chars": max(0, len(prompt) - placed),
+        "sections": rows,
+    }
+    try:
+        PROMPT_PROFILE_LOG.parent.mkdir(parents=True, exist_ok=True)
+        with PROMPT_PROFILE_LOG.open("a", encoding="utf-8") as f:
+            f.write(json.dumps(record) + "\n")
+    except Exception as e:
+        print(f"  {Colors.YELLOW}[prompts]{Colors.RESET} profile write failed: {e}")
+
+
+def print_prompt_profile(label: Optional[str] = None, limit: int = 10, days: Optional[int] = None):
+    """Aggregate prompt profiles by label: token share and truncation per section."""
+    if not PROMPT_PROFILE_LOG.exists():
+        print(f"  {Colors.GRAY}No prompt profiles yet (set ORCHESTRATOR_PROMPT_PROFILE=1){Colors.RESET}")
+        return
+
+    cutoff = (datetime.now().timestamp() - days * 86400) if days else None
+    labels: dict[str, dict] = {}
+    for line in PROMPT_PROFILE_LOG.read_text().splitlines():
+        try:
+            rec = json.loads(line)
+        except ValueError:
+            continue
+        if label and not rec.get("label", "").startswith(label):
+            continue
+        if cutoff and datetime.fromisoformat(rec["ts"]).timestamp() < cutoff:
+            continue
+        agg = labels.setdefault(rec["label"], {"calls": 0, "chars": 0, "template": 0, "sections": {}, "days": {}})
+        agg["calls"] += 1
+        agg["chars"] += rec["prompt_chars"]
+        agg["template"] += rec["template_chars"]
+        day = agg["days"].setdefault(rec["ts"][:10], [0, 0])
+        day[0] += 1
+        day[1] += rec["prompt_tokens"]
+        for sec in rec["sections"]:
+            s = agg["sections"].setdefault(sec["name"], {"chars": 0, "original": 0, "kept": 0, "dupes": 0, "dropped": 0})
+            s["chars"] += sec["chars"]
+            s["original"] += sec["original_chars"]
+            s["kept"] += sec["original_chars"] - sec["truncated_chars"]
+            s["dupes"] += sec["occurrences"] > 1
+            s["dropped"] += sec["occurrences"] == 0
+
+    shares, losses = [], []
+    for name, agg in sorted(labels.items(), key=lambda kv: -kv[1]["chars"]):
+        calls = agg["calls"]
+        print(f"\n  {Colors.CYAN}{name}{Colors.RESET}  calls={calls}  avg prompt ≈{agg['chars'] / calls / 4:.0f} tokens")
+        trend = "  ".join(f"{d}: {v[1] // v[0]}" for d, v in sorted(agg["days"].items())[-5:])
+        print(f"    {Colors.GRAY}avg tokens by day: {trend}{Colors.RESET}")
+        rows = [("(template/instructions)", {"chars": agg["template"], "original": 0, "kept": 0, "dupes": 0, "dropped": 0})]
+        rows += list(agg["sections"].items())
+        for sec_name, s in sorted(rows, key=lambda kv: -kv[1]["chars"]):
+            share = s["chars"] / agg["chars"] if agg["chars"] else 0.0
+            loss = 1 - s["kept"] / s["original"] if s["original"] else 0.0
+            flags = []
+            if s["dupes"]:
+                flags.append(f"duplicated in {s['dupes']}/{calls}")
+            if s["dropped"]:
+                flags.append(f"dropped in {s['dropped']}/{calls}")
+            flag_text = f"  {Colors.YELLOW}{', '.join(flags)}{Colors.RESET}" if flags else ""
+            print(f"    {sec_name[:32]:<32} {share:>6.1%} of tokens  truncation loss {loss:>6.1%}{flag_text}")
+            shares.append((share, name, sec_name))
+            if loss > 0:
+                losses.append((loss, name, sec_name))
+
+    print(f"\n  {Colors.CYAN}Highest token share:{Colors.RESET}")
+    for share, name, sec_name in sorted(shares, reverse=True)[:limit]:
+        print(f"    {share:>6.1%}  {name} → {sec_name}")
+    print(f"\n  {Colors.CYAN}Worst truncation loss:{Colors.RESET}")
+    for loss, name, sec_name in sorted(losses, reverse=True)[:limit]:
+        print(f"    {loss:>6.1%}  {name} → {sec_name}")
+    print()
+
+
 def _estimate_tokens(text: str) -> int:
     if not text:
         return 0
@@ -234,18 +712,24 @@ def _load_cache(cache_key: str) -> Optional[str]:
         return None
     try:
         data = json.loads(path.read_text())
-        return data.get("output", "")
     except Exception:
         return None
+    return data.get("output", "")
 
 
-def _save_cache(cache_key: str, output_text: str):
+def _save_cache(cache_key: str, output_text: str, label: Optional[str] = None):
     if os.getenv("ORCHESTRATOR_CACHE") == "0":
         return
+    data = {"ts": datetime.now().isoformat(), "key": cache_key, "label": label, "output": output_text}
+    _write_cache_entry(_cache_path(cache_key), data)
+
+
+def _write_cache_entry(path: Path, data: dict):
     try:
-        CACHE_DIR.mkdir(parents=True, exist_ok=True)
-        data = {"ts": datetime.now().isoformat(), "output": output_text}
-        _cache_path(cache_key).write_text(json.dumps(data, indent=2))
+        path.parent.mkdir(parents=True, exist_ok=True)
+        tmp = path.with_name(f".{path.name}.{os.getpid()}.{threading.get_ident()}.tmp")
+        tmp.write_text(json.dumps(data, indent=2))
+        os.replace(tmp, path)
     except Exception as e:
         print(f"  {Colors.YELLOW}[cache]{Colors.RESET} write failed: {e}")
 
@@ -268,7 +752,8 @@ def _select_model(config: dict, usage_label: str) -> Optional[str]:
     return os.getenv("ORCHESTRATOR_CHEAP_MODEL") or config.get("cheap_model") or base_model
 
 
-def _log_usage(label: str, cli: str, model: Optional[str], in_tokens: int, out_tokens: int, elapsed: float):
+def _log_usage(label: str, cli: str, model: Optional[str], in_tokens: int, out_tokens: int, elapsed: float,
+               extra: Optional[dict] = None):
     usage = {
         "ts": datetime.now().isoformat(),
         "label": label,
@@ -279,20 +764,114 @@ def _log_usage(label: str, cli: str, model: Optional[str], in_tokens: int, out_t
         "total_tokens": in_tokens + out_tokens,
         "elapsed_sec": round(elapsed, 3),
     }
+    if _ATTRIBUTION.get():
+        usage["attribution"] = list(_ATTRIBUTION.get())
+    if extra:
+        usage.update(extra)
+    path = EVAL_USAGE_LOG if label.startswith("eval:") else USAGE_LOG
     try:
-        USAGE_LOG.parent.mkdir(parents=True, exist_ok=True)
-        with USAGE_LOG.open("a", encoding="utf-8") as f:
+        path.parent.mkdir(parents=True, exist_ok=True)
+        with path.open("a", encoding="utf-8") as f:
             f.write(json.dumps(usage) + "\n")
     except Exception as e:
         print(f"  {Colors.YELLOW}[usage]{Colors.RESET} log write failed: {e}")
 
 
+def load_usage_records(path: Path = USAGE_LOG) -> list[dict]:
+    """Load usage.jsonl records, skipping malformed lines."""
+    if not path.exists():
+        return []
+    records = []
+    for line in path.read_text().splitlines():
+        try:
+            records.append(json.loads(line))
+        except ValueError:
+            continue
+    return records
+
+
+def model_prices() -> dict:
+    prices = dict(MODEL_PRICES)
+    for item in (os.getenv("ORCHESTRATOR_PRICES") or "").split(","):
+        if "=" not in item or "/" not in item:
+            continue
+        name, rates = item.split("=", 1)
+        try:
+            in_rate, out_rate = (float(x) for x in rates.split("/", 1))
+        except ValueError:
+            continue
+        prices[name.strip()] = (in_rate, out_rate)
+    return prices
+
+
+def estimate_cost(model: Optional[str], in_tokens: int, out_tokens: int,
+                  prices: Optional[dict] = None) -> float:
+    """Estimated USD cost of a call from the model price table."""
+    prices = prices or model_prices()
+    in_rate, out_rate = prices.get(model or "default", prices["default"])
+    return (in_tokens * in_rate + out_tokens * out_rate) / 1_000_000
+
+
 def print_usage(label: str, model: Optional[str], in_tokens: int, out_tokens: int):
     total = in_tokens + out_tokens
     model_note = f" model={model}" if model else ""
     print(f"  {Colors.GRAY}[usage]{Colors.RESET} {label}:{model_note} in≈{in_tokens} out≈{out_tokens} total≈{total}")
 
 
+# ============================================================================
+# EVALUATION CORPUS
+# ============================================================================
+
+# Judgment calls whose output can be scored offline; implement/correct act on
+# the workspace and are not replayable
+DEFAULT_EVAL_LABELS = (
+    "rpi:research",
+    "rpi:plan",
+    "rpi:grade",
+    "tracer:clarify",
+    "tracer:ticket",
+    "tracer:execute:review",
+    "tracer:execute:monitor",
+    "tracer:execute:verify",
+    "orch:locator",
+)
+
+
+def eval_recording_labels() -> tuple[str, ...]:
+    """ORCHESTRATOR_EVAL_RECORD=1 records the default labels; a comma list picks prefixes."""
+    raw = os.getenv("ORCHESTRATOR_EVAL_RECORD", "")
+    if raw in ("", "0"):
+        return ()
+    if raw == "1":
+        return DEFAULT_EVAL_LABELS
+    return tuple(l.strip() for l in raw.split(",") if l.strip())
+
+
+def _record_eval_sample(usage_label: str, cli: str, model: Optional[str], prompt: str,
+                        output: str, elapsed: float):
+    labels = eval_recording_labels()
+    if not any(usage_label.startswith(label) for label in labels):
+        return
+    sample = {
+        "id": hashlib.sha256(f"{usage_label}\0{prompt}".encode("utf-8")).hexdigest()[:16],
+        "ts": datetime.now().isoformat(),
+        "label": usage_label,
+        "cli": cli,
+        "model": model,
+        "prompt": prompt,
+        "output": output,
+        "elapsed_sec": round(elapsed, 3),
+        "in_tokens": _estimate_tokens(prompt),
+        "out_tokens": _estimate_tokens(output),
+    }
+    try:
+        EVAL_CORPUS.parent.mkdir(parents=True, exist_ok=True)
+        with EVAL_CORPUS.open("a", encoding="utf-8") as f:
+            f.write(json.dumps(sample) + "\n")
+    except Exception as e:
+        print(f"  {Colors.YELLOW}[eval]{Colors.RESET} corpus write failed: {e}")
+
+
 # ============================================================================
 # SCORE EXTRACTION
 # ============================================================================
@@ -409,7 +988,8 @@ def load_command_prompt(command_name: str) -> str:
         if content.startswith("---"):
             parts = content.split("---", 2)
             if len(parts) >= 3:
-                return parts[2].strip()
+                content = parts[2].strip()
+        note_prompt_section(f"command:{command_name}", content)
         return content
     return ""
 
@@ -423,7 +1003,8 @@ def load_agent_prompt(agent_name: str) -> str:
         if content.startswith("---"):
             parts = content.split("---", 2)
             if len(parts) >= 3:
-                return parts[2].strip()
+                content = parts[2].strip()
+        note_prompt_section(f"agent:{agent_name}", content)
         return content
     return ""
 
@@ -475,15 +1056,233 @@ def _extract_heading_section(text: str, token: str) -> str:
 
 def load_project_context(path: Path, max_chars: int,
                          story_id: Optional[str] = None,
-                         story_name: Optional[str] = None) -> str:
+                         story_name: Optional[str] = None,
+                         section_name: Optional[str] = None,
+                         critical: tuple[str, ...] = ()) -> str:
     if not path.exists():
         return ""
-    text = path.read_text()
+    full = path.read_text()
+    text = full
     for token in [story_id, story_name]:
         section = _extract_heading_section(text, token) if token else ""
         if section:
-            return compact_text(section, max_chars)
-    return compact_text(text, max_chars)
+            text = section
+            break
+    if context_mode() == "pointer":
+        first_line = full[:max(0, full.find(text))].count("\n") + 1
+        compacted = compact_text(pointer_context(path, text, max_chars, first_line, critical), max_chars)
+    else:
+        compacted = compact_text(text, max_chars)
+    note_prompt_section(section_name or path.name, compacted, len(text))
+    return compacted
+
+
+# ============================================================================
+# POINTER-MODE CONTEXT
+# ============================================================================
+
+DEFAULT_CRITICAL_HEADINGS = ("summary", "requirements", "acceptance", "constraints", "steps")
+DEFAULT_POINTER_BUDGET = 600        # tokens of optional sections inlined per document
+POINTER_MIN_TOKENS = 300            # smaller documents are always inlined whole
+POINTER_MIN_SAMPLES = 3             # pointers issued before read history counts
+POINTER_HIGH_READ_RATE = 0.6        # agents read it anyway: inline up to max_chars
+POINTER_LOW_READ_RATE = 0.2         # agents rarely follow it: inline critical sections only
+POINTER_SUMMARY_CHARS = 120
+READ_TOOLS = ("Read", "read_file")
+
+_POINTER_LOCK = threading.Lock()
+_READ_SPANS: dict = {"key": None, "spans": []}
+
+
+def context_mode() -> str:
+    """inline (default) or pointer."""
+    return os.getenv("ORCHESTRATOR_CONTEXT_MODE", "inline").strip().lower()
+
+
+def critical_headings() -> tuple[str, ...]:
+    raw = os.getenv("ORCHESTRATOR_CONTEXT_CRITICAL")
+    if raw is None:
+        return DEFAULT_CRITICAL_HEADINGS
+    return tuple(h.strip().lower() for h in raw.split(",") if h.strip())
+
+
+def pointer_budget() -> int:
+    try:
+        return max(0, int(os.getenv("ORCHESTRATOR_CONTEXT_BUDGET", DEFAULT_POINTER_BUDGET)))
+    except ValueError:
+        return DEFAULT_POINTER_BUDGET
+
+
+@dataclass
+class DocSection:
+    heading: str        # "" for text before the first heading
+    start: int          # 1-based line numbers within the file
+    end: int
+    text: str
+
+
+def split_doc_sections(text: str, first_line: int = 1) -> list[DocSection]:
+    """
+    Split markdown at the shallowest heading level that occurs more than once
+    (so a lone "# Title" stays with its preamble). Headings inside code fences
+    do not count.
+    """
+    lines = text.splitlines()
+    header_re = re.compile(r'^(#{1,6})\s+(.+?)\s*#*\s*$')
+    headings = []
+    fenced = False
+    for i, line in enumerate(lines):
+        if line.lstrip().startswith("```"):
+            fenced = not fenced
+            continue
+        match = None if fenced else header_re.match(line)
+        if match:
+            headings.append((i, len(match.group(1)), match.group(2).strip()))
+
+    levels = [level for _, level, _ in headings]
+    split_level = min((l for l in set(levels) if levels.count(l) > 1), default=None)
+    starts = [(i, title) for i, level, title in headings if level == split_level]
+    if not starts:
+        return [DocSection("", first_line, first_line + len(lines) - 1, text)]
+
+    bounds = ([(0, "")] if starts[0][0] > 0 else []) + starts
+    sections = []
+    for n, (i, title) in enumerate(bounds):
+        end = bounds[n + 1][0] if n + 1 < len(bounds) else len(lines)
+        body = "\n".join(lines[i:end]).strip()
+        if body:
+            sections.append(DocSection(title, first_line + i, first_line + end - 1, body))
+    return sections
+
+
+def _section_summary(section: DocSection) -> str:
+    """First line of prose under the heading, stripped of markdown markers."""
+    for line in section.text.splitlines()[1 if section.heading else 0:]:
+        line = line.strip().lstrip("-*>|#0123456789. ").strip()
+        if line and not line.startswith("```") and not set(line) <= set("-|: "):
+            return line if len(line) <= POINTER_SUMMARY_CHARS else line[:POINTER_SUMMARY_CHARS - 1] + "…"
+    return "(no text)"
+
+
+def _anchor(heading: str) -> str:
+    slug = re.sub(r"[^\w\s-]", "", heading.lower()).strip()
+    return re.sub(r"\s+", "-", slug)
+
+
+def _workspace_path(path: Path) -> str:
+    try:
+        return str(path.resolve().relative_to(WORKSPACE.resolve()))
+    except ValueError:
+        return str(path)
+
+
+def _read_spans() -> list[tuple[str, str]]:
+    """(ts, workspace-relative path) of file-read tool calls in the trace, cached per trace size."""
+    try:
+        st = TRACE_LOG.stat()
+    except OSError:
+        return []
+    key = (st.st_mtime, st.st_size)
+    if _READ_SPANS["key"] != key:
+        spans = []
+        for line in TRACE_LOG.read_text(errors="replace").splitlines():
+            try:
+                span = json.loads(line)
+            except ValueError:
+                continue
+            path = span.get("args_path")
+            if span.get("tool") in READ_TOOLS and path:
+                path = Path(path)
+                spans.append((span.get("ts", ""), _workspace_path(path if path.is_absolute() else WORKSPACE / path)))
+        _READ_SPANS.update(key=key, spans=spans)
+    return _READ_SPANS["spans"]
+
+
+def pointer_read_rate(rel_path: str) -> Optional[float]:
+    """
+    Reads of a file per prompt that pointed at it, from the tool-call trace
+    (ORCHESTRATOR_TRACE_TOOLS=1). None until enough pointers were issued.
+    """
+    try:
+        entry = json.loads(CONTEXT_POINTERS.read_text()).get(rel_path)
+    except (OSError, ValueError):
+        return None
+    if not entry or entry.get("pointers", 0) < POINTER_MIN_SAMPLES:
+        return None
+    reads = sum(1 for ts, path in _read_spans() if ts >= entry["since"] and path == rel_path)
+    return min(1.0, reads / entry["pointers"])
+
+
+def _note_pointer(rel_path: str):
+    with _POINTER_LOCK:
+        try:
+            stats = json.loads(CONTEXT_POINTERS.read_text())
+        except (OSError, ValueError):
+            stats = {}
+        entry = stats.setdefault(rel_path, {"since": datetime.now().isoformat(), "pointers": 0})
+        entry["pointers"] += 1
+        try:
+            CONTEXT_POINTERS.parent.mkdir(parents=True, exist_ok=True)
+            tmp = CONTEXT_POINTERS.with_suffix(f".{os.getpid()}.tmp")
+            tmp.write_text(json.dumps(stats, indent=2))
+            os.replace(tmp, CONTEXT_POINTERS)
+        except OSError as e:
+            print(f"  {Colors.YELLOW}[context]{Colors.RESET} pointer stats write failed: {e}")
+
+
+def choose_inline(sections: list[DocSection], budget: int,
+                  critical: tuple[str, ...] = ()) -> list[bool]:
+    """Critical sections and the preamble always; then optional ones, smallest first, within budget."""
+    critical = tuple(c.lower() for c in critical) + critical_headings()
+    inline = []
+    for s in sections:
+        heading = s.heading.lower()
+        inline.append(not s.heading or "*" in critical or any(c in heading for c in critical))
+    spent = 0
+    for i in sorted((i for i, keep in enumerate(inline) if not keep),
+                    key=lambda i: len(sections[i].text)):
+        tokens = _estimate_tokens(sections[i].text)
+        if spent + tokens > budget:
+            break
+        inline[i] = True
+        spent += tokens
+    return inline
+
+
+def pointer_context(path: Path, text: str, max_chars: int, first_line: int = 1,
+                    critical: tuple[str, ...] = ()) -> str:
+    """
+    Inline the sections of `text` the prompt needs and replace the rest with a
+    path, line range, heading anchor and one-line summary the agent can Read.
+    """
+    if _estimate_tokens(text) <= POINTER_MIN_TOKENS:
+        return text
+    sections = split_doc_sections(text, first_line)
+    rel_path = _workspace_path(path)
+
+    rate = pointer_read_rate(rel_path)
+    if rate is not None and rate >= POINTER_HIGH_READ_RATE:
+        budget = max_chars // 4
+    elif rate is not None and rate < POINTER_LOW_READ_RATE:
+        budget = 0
+    else:
+        budget = pointer_budget()
+
+    inline = choose_inline(sections, budget, critical)
+    if all(inline):
+        return text
+
+    parts = []
+    for section, keep in zip(sections, inline):
+        if keep:
+            parts.append(section.text)
+        else:
+            parts.append(f"→ **{section.heading}**: not inlined; `{rel_path}#{_anchor(section.heading)}` "
+                         f"lines {section.start}-{section.end} (~{_estimate_tokens(section.text)} tokens). "
+                         f"{_section_summary(section)}")
+    _note_pointer(rel_path)
+    return (f"_Sections marked → are in `{rel_path}`; Read the given lines when you need them._\n\n"
+            + "\n\n".join(parts))
 
 
 # ============================================================================
@@ -530,8 +1329,14 @@ def print_header(title: str, subtitle: str = "", color: str = None):
     print(f"{c}{'═' * 70}{Colors.RESET}")
 
 
+# Callbacks invoked with the phase name whenever a phase banner is printed
+PHASE_HOOKS: list[Callable[[str], None]] = []
+
+
 def print_phase(phase: str, description: str = ""):
-    """Print a phase banner."""
+    """Print a phase banner and notify phase hooks."""
+    for hook in list(PHASE_HOOKS):
+        hook(phase)
     icons = {
         "RESEARCH": "🔍",
         "PLAN": "📋",